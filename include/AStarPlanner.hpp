@@ -0,0 +1,22 @@
+#pragma once
+
+#include "PathPlanner.hpp"
+
+namespace kinematic
+{
+
+class AStarPlanner:
+    public PathPlanner
+{
+public:
+    AStarPlanner();
+    virtual ~AStarPlanner();
+
+    virtual bool findPath(
+        const ConfigurationSpace& space,
+        glm::ivec2 start,
+        glm::ivec2 end
+    ) override;
+};
+
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace kinematic
+{
+
+// Hands out storage starting on an `Alignment` byte boundary, which must
+// be a power of two. The block is over-allocated and the pointer that
+// operator new returned is kept just in front of the aligned start.
+template<typename T, std::size_t Alignment>
+class AlignedAllocator
+{
+public:
+    using value_type = T;
+
+    template<typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator()
+    {
+    }
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&)
+    {
+    }
+
+    T* allocate(std::size_t count)
+    {
+        auto block = static_cast<char*>(
+            ::operator new(count * sizeof(T) + sizeof(void*) + Alignment - 1)
+        );
+
+        auto address = reinterpret_cast<std::uintptr_t>(block)
+            + sizeof(void*);
+        address = (address + Alignment - 1) & ~(Alignment - 1);
+
+        auto start = reinterpret_cast<void**>(address);
+        start[-1] = block;
+        return reinterpret_cast<T*>(start);
+    }
+
+    void deallocate(T* pointer, std::size_t)
+    {
+        ::operator delete(reinterpret_cast<void**>(pointer)[-1]);
+    }
+};
+
+template<typename T, typename U, std::size_t Alignment>
+bool operator==(
+    const AlignedAllocator<T, Alignment>&,
+    const AlignedAllocator<U, Alignment>&
+)
+{
+    return true;
+}
+
+template<typename T, typename U, std::size_t Alignment>
+bool operator!=(
+    const AlignedAllocator<T, Alignment>&,
+    const AlignedAllocator<U, Alignment>&
+)
+{
+    return false;
+}
+
+}
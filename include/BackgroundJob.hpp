@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <thread>
+
+#include "JobProgress.hpp"
+
+namespace kinematic
+{
+
+// Runs one piece of work at a time on a thread of its own, so that long
+// computations do not stall the render loop. The work returns whether it
+// produced a result; the owner polls the job every frame and the finishing
+// step, which may touch GL and the owner's state, runs inside poll(). A
+// cancelled job is left to wind down and its result is dropped.
+class BackgroundJob
+{
+public:
+    BackgroundJob();
+    ~BackgroundJob();
+
+    // Cancels and waits for the previous work first.
+    void start(
+        std::function<bool(JobProgress&)> work,
+        std::function<void()> finish
+    );
+
+    void cancel();
+
+    // True when the work completed and its finishing step ran.
+    bool poll();
+
+    // Stays true for a cancelled job until its thread is done.
+    bool isRunning() const;
+    bool isCancelled() const;
+    float getProgress() const;
+
+private:
+    void stop();
+
+    std::thread _thread;
+    JobProgress _progress;
+    std::function<void()> _finish;
+    std::atomic<bool> _done;
+    bool _succeeded;
+};
+
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "PathPlanner.hpp"
+
+namespace kinematic
+{
+
+class BidirectionalPlanner:
+    public PathPlanner
+{
+public:
+    BidirectionalPlanner();
+    virtual ~BidirectionalPlanner();
+
+    virtual bool findPath(
+        const ConfigurationSpace& space,
+        glm::ivec2 start,
+        glm::ivec2 end
+    ) override;
+
+    // Cells only the backward search reached show its distances.
+    virtual int getSearchMapState(glm::ivec2 coord) const override;
+
+private:
+    int getDistance(bool forward, int index) const;
+    void visit(bool forward, int index, int distance, glm::ivec2 parent);
+    glm::ivec2 getReverseTraceback(int index) const;
+
+    void stitchPath(glm::ivec2 forwardMeet, glm::ivec2 backwardMeet);
+
+    std::vector<int> _reverseSearchMap;
+    std::vector<glm::ivec2> _reverseSearchMapTraceback;
+    std::vector<std::uint32_t> _reverseStamps;
+
+    std::vector<glm::ivec2> _forwardFrontier;
+    std::vector<glm::ivec2> _backwardFrontier;
+    std::vector<glm::ivec2> _nextFrontier;
+};
+
+}
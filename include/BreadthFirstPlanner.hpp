@@ -0,0 +1,28 @@
+#pragma once
+
+#include "PathPlanner.hpp"
+#include "SearchWorkspace.hpp"
+
+namespace kinematic
+{
+
+class BreadthFirstPlanner:
+    public PathPlanner
+{
+public:
+    BreadthFirstPlanner();
+    virtual ~BreadthFirstPlanner();
+
+    virtual bool findPath(
+        const ConfigurationSpace& space,
+        glm::ivec2 start,
+        glm::ivec2 end
+    ) override;
+
+private:
+    void trackbackDirections(glm::ivec2 start, glm::ivec2 end);
+
+    SearchWorkspace _workspace;
+};
+
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace kinematic
+{
+
+// Priority queue for small integer keys (Dial's buckets). Keys must never
+// drop below the key last popped nor reach `span` past it, which holds for
+// searches with a consistent heuristic whose keys grow by less than `span`
+// per edge. Push and pop are constant time, and bucket storage is kept
+// between searches.
+class BucketQueue
+{
+public:
+    BucketQueue();
+    ~BucketQueue();
+
+    void reset(int span);
+
+    bool isEmpty() const;
+    void push(std::uint32_t value, int key);
+    std::uint32_t pop();
+    int getCurrentKey() const;
+
+private:
+    std::vector<std::vector<std::uint32_t>> _buckets;
+    int _span;
+    int _currentKey;
+    int _size;
+};
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <memory>
+
+#include "ConfigurationSpace.hpp"
+#include "KinematicChain.hpp"
+
+namespace kinematic
+{
+
+// Configuration space of a chain with any number of joints: a torus with
+// one wrapping axis per joint. Obstacles are borrowed from a planar
+// configuration space so both share one set of constraints and its index.
+class ChainConfigurationSpace
+{
+public:
+    ChainConfigurationSpace();
+    ~ChainConfigurationSpace();
+
+    void setChain(const KinematicChain& chain);
+    const KinematicChain& getChain() const;
+    int getDimension() const;
+
+    void setObstacles(std::shared_ptr<const ConfigurationSpace> obstacles);
+
+    // Changes whenever the chain, the obstacle space or its revision does.
+    unsigned long getRevision() const;
+
+    // Links are placed and tested one at a time from the base, so a
+    // collision early in the chain skips the rest.
+    bool checkConfiguration(const float* angles) const;
+    bool checkConfiguration(const JointVector& angles) const;
+
+    // Walks the shortest move between two configurations, stopping at the
+    // first collision. Configurations are checked often enough that no
+    // point of the chain travels more than `maxTravel` in the workspace
+    // between two of them, against constraints grown by half of that, so
+    // nothing in between can touch a constraint unnoticed. A two-joint
+    // chain matching a built availability map traces the move through
+    // the map cells instead, which misses nothing the conservative map
+    // blocks.
+    bool checkMotion(
+        const float* from,
+        const float* to,
+        float maxTravel
+    ) const;
+
+    float getDistance(const JointVector& from, const JointVector& to) const;
+
+    static float wrapAngle(float angle);
+    static float getAngleDifference(float from, float to);
+
+private:
+    bool checkLinks(const float* angles, float margin) const;
+    bool isMapBacked() const;
+    bool checkMapMotion(const float* from, const float* to) const;
+
+    KinematicChain _chain;
+    std::shared_ptr<const ConfigurationSpace> _obstacles;
+    unsigned long _revision;
+};
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+
+#include "ChainConfigurationSpace.hpp"
+
+namespace kinematic
+{
+
+// Planner over the configuration space of a chain with any number of
+// joints. Paths run from the exact start to the exact goal; consecutive
+// configurations are meant to be joined by shortest moves on the torus.
+class ChainPlanner
+{
+public:
+    ChainPlanner();
+    virtual ~ChainPlanner();
+
+    virtual bool findPath(
+        const ChainConfigurationSpace& space,
+        const JointVector& start,
+        const JointVector& goal
+    ) = 0;
+
+    const std::vector<JointVector>& getPath() const;
+    int getExpandedNodes() const;
+
+protected:
+    void resetSearch();
+
+    int _expandedNodes;
+    std::vector<JointVector> _path;
+};
+
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "fw/AABB.hpp"
+
+namespace kinematic
+{
+
+// Separating axis test between a closed segment and a closed box. Touching
+// counts as a collision, same as fw::AABB::contains.
+inline bool intersectSegmentAABB(
+    const glm::vec2& start,
+    const glm::vec2& end,
+    const fw::AABB<glm::vec2>& aabb
+)
+{
+    auto halfX = 0.5f * (end.x - start.x);
+    auto halfY = 0.5f * (end.y - start.y);
+    auto extentX = 0.5f * (aabb.max.x - aabb.min.x);
+    auto extentY = 0.5f * (aabb.max.y - aabb.min.y);
+    auto deltaX = 0.5f * (start.x + end.x) - 0.5f * (aabb.min.x + aabb.max.x);
+    auto deltaY = 0.5f * (start.y + end.y) - 0.5f * (aabb.min.y + aabb.max.y);
+
+    auto absHalfX = std::fabs(halfX);
+    auto absHalfY = std::fabs(halfY);
+
+    return std::fabs(deltaX) <= extentX + absHalfX
+        && std::fabs(deltaY) <= extentY + absHalfY
+        && std::fabs(halfX * deltaY - halfY * deltaX)
+            <= extentX * absHalfY + extentY * absHalfX;
+}
+
+class AABBBatch
+{
+public:
+    static const int cLaneCount;
+
+    AABBBatch();
+    ~AABBBatch();
+
+    void assign(const std::vector<fw::AABB<glm::vec2>>& boxes);
+    void set(int index, const fw::AABB<glm::vec2>& box);
+
+    int size() const;
+
+    // Boxes are grown by `margin` on every side for the test.
+    bool intersectsSegment(
+        const glm::vec2& start,
+        const glm::vec2& end,
+        float margin = 0.0f
+    ) const;
+
+private:
+    int _count;
+    std::vector<float> _centerX, _centerY;
+    std::vector<float> _extentX, _extentY;
+};
+
+// Tests `count` segments given as structure of arrays against one box and
+// ORs the result into `hits`.
+void collideSegmentsWithAABB(
+    const float* startX,
+    const float* startY,
+    const float* endX,
+    const float* endY,
+    int count,
+    const fw::AABB<glm::vec2>& aabb,
+    unsigned char* hits
+);
+
+// Range of directions, seen from `centre`, of the part of the box lying
+// within `radius` of it. Returns false when that part is empty; a box
+// containing the centre yields a full turn starting at -pi.
+bool getAABBSectorInDisk(
+    const glm::vec2& centre,
+    float radius,
+    const fw::AABB<glm::vec2>& aabb,
+    float& lowAngle,
+    float& highAngle
+);
+
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "fw/AABB.hpp"
+
+#include "CollisionKernels.hpp"
+#include "ConstraintIndex.hpp"
+#include "JobProgress.hpp"
+#include "OccupancyGrid.hpp"
+#include "ThreadPool.hpp"
+#include "TrigonometryTable.hpp"
+
+namespace kinematic
+{
+
+class ConfigurationSpace
+{
+public:
+    ConfigurationSpace();
+    ~ConfigurationSpace();
+
+    void setThreadPool(std::shared_ptr<ThreadPool> threadPool);
+    std::shared_ptr<ThreadPool> getThreadPool() const;
+
+    void setArmLengths(float firstArmLength, float secondArmLength);
+    float getFirstArmLength() const;
+    float getSecondArmLength() const;
+
+    void setConstraints(const std::vector<fw::AABB<glm::vec2>>& constraints);
+    int addConstraint(const fw::AABB<glm::vec2>& constraint);
+    void setConstraint(int index, const fw::AABB<glm::vec2>& constraint);
+    void removeConstraint(int index);
+    const std::vector<fw::AABB<glm::vec2>>& getConstraints() const;
+    int findConstraint(glm::vec2 point) const;
+
+    std::pair<glm::vec2, glm::vec2> buildConfiguration(
+        float alpha,
+        float beta
+    ) const;
+
+    bool checkConfiguration(float alpha, float beta) const;
+    // Constraints are grown by `margin` on every side for the test.
+    bool checkArmConstraintCollision(
+        glm::vec2 start,
+        glm::vec2 end,
+        float margin = 0.0f
+    ) const;
+
+    bool checkSegmentAABBCollision(
+        const glm::vec2& start,
+        const glm::vec2& end,
+        const fw::AABB<glm::vec2>& aabb
+    ) const;
+
+    // Reports the share of rows done and stops early, returning false and
+    // leaving no map, once `progress` gets cancelled.
+    bool createAvailabilityMap(JobProgress* progress = nullptr);
+    bool isAvailabilityMapCreated() const;
+    const OccupancyGrid& getOccupancyGrid() const;
+
+    // Changes with every edit of the constraints, arms or resolution and
+    // every map build, and copies keep it. Numbers come from one counter
+    // shared by all spaces, which createRevision advances.
+    unsigned long getRevision() const;
+    static unsigned long createRevision();
+
+    void setResolution(int resolution);
+    int getResolution() const;
+    float getCellAngle(int step) const;
+    glm::vec2 getCellAngles(glm::ivec2 coord) const;
+
+    glm::ivec2 getClosestInConfiguration(glm::vec2 coord) const;
+    bool verifyAvailability(glm::ivec2 coord) const;
+
+    // Traces a segment given in cell units, starting at `from` (cell
+    // centres lie on integers) and moving by `delta`, wrapping at the map
+    // edges. True when every cell it passes through is free.
+    bool checkCellLine(glm::vec2 from, glm::vec2 delta) const;
+
+private:
+    bool updateConstraintFootprints(
+        const std::vector<fw::AABB<glm::vec2>>& removed,
+        const std::vector<fw::AABB<glm::vec2>>& added,
+        JobProgress* progress
+    );
+
+    bool rasterizeConstraintRow(
+        const fw::AABB<glm::vec2>& reach,
+        int alphaStep,
+        int delta
+    );
+
+    void addObstacleSpan(
+        int alphaStep,
+        int firstBetaStep,
+        int count,
+        int delta
+    );
+
+    void refreshAvailabilityRow(int alphaStep);
+
+    std::shared_ptr<ThreadPool> _threadPool;
+
+    float _firstArmLength, _secondArmLength;
+    std::vector<fw::AABB<glm::vec2>> _constraints;
+    AABBBatch _constraintBatch;
+    ConstraintIndex _constraintIndex;
+
+    int _resolution;
+    TrigonometryTable _trigonometryTable;
+    bool _availabilityMapCreated;
+    unsigned long _revision;
+    std::vector<std::uint32_t> _obstacleCount;
+    OccupancyGrid _occupancyGrid;
+};
+
+}
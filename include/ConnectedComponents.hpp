@@ -0,0 +1,41 @@
+#pragma once
+
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "OccupancyGrid.hpp"
+#include "ThreadPool.hpp"
+
+namespace kinematic
+{
+
+// Labels the free cells of a wrapping occupancy grid. Each component is
+// named after its smallest cell index, so labels do not depend on how the
+// work was split between threads.
+class ConnectedComponents
+{
+public:
+    static const int cOccupiedLabel;
+
+    ConnectedComponents();
+    ~ConnectedComponents();
+
+    void build(const OccupancyGrid& grid, ThreadPool& threadPool);
+
+    int getLabel(glm::ivec2 coord) const;
+    bool areConnected(glm::ivec2 first, glm::ivec2 second) const;
+    int getComponentCount() const;
+
+private:
+    int find(int cell) const;
+    int findAndCompress(int cell);
+    void unite(int first, int second);
+
+    int _columns;
+    int _componentCount;
+    std::vector<int> _parent;
+    std::vector<int> _labels;
+};
+
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "fw/AABB.hpp"
+
+namespace kinematic
+{
+
+// Uniform grid over the workspace holding box indices per cell. Indices
+// follow the owner's vector, including its swap-and-pop removal. Boxes too
+// large for the grid are kept aside and tested by every query.
+class ConstraintIndex
+{
+public:
+    static const float cDefaultCellSize;
+
+    ConstraintIndex();
+    ~ConstraintIndex();
+
+    void setCellSize(float cellSize);
+    float getCellSize() const;
+
+    void assign(const std::vector<fw::AABB<glm::vec2>>& boxes);
+    void add(const fw::AABB<glm::vec2>& box);
+    void set(int index, const fw::AABB<glm::vec2>& box);
+    void remove(int index);
+
+    int size() const;
+
+    // Boxes are grown by `margin` on every side for the test.
+    bool intersectsSegment(
+        const glm::vec2& start,
+        const glm::vec2& end,
+        float margin = 0.0f
+    ) const;
+
+    // Lowest index of a box containing the point, -1 if there is none.
+    int findContaining(const glm::vec2& point) const;
+
+private:
+    glm::ivec2 getCell(const glm::vec2& point) const;
+    std::uint64_t getKey(glm::ivec2 cell) const;
+
+    bool isOversized(const fw::AABB<glm::vec2>& box) const;
+    void link(int index);
+    void unlink(int index);
+
+    bool intersectsCell(
+        glm::ivec2 cell,
+        const glm::vec2& start,
+        const glm::vec2& end,
+        float margin
+    ) const;
+
+    float _cellSize;
+    std::vector<fw::AABB<glm::vec2>> _boxes;
+    std::unordered_map<std::uint64_t, std::vector<int>> _cells;
+    std::vector<int> _oversized;
+};
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "ConfigurationSpace.hpp"
+
+namespace kinematic
+{
+
+// Integer step costs over the wrapping configuration space. Entering a
+// free cell costs more the closer it lies to an obstacle, by its exact
+// Euclidean clearance from a distance transform of the availability map,
+// and moves along each joint are scaled by that joint's weight. The map
+// stays valid until the configuration space changes its revision or a
+// setting changes.
+class CostMap
+{
+public:
+    static const int cCostScale;
+    static const float cDefaultJointWeight;
+    static const int cDefaultClearanceRange;
+    static const float cDefaultClearancePenalty;
+
+    CostMap();
+    ~CostMap();
+
+    void setJointWeights(glm::vec2 jointWeights);
+    glm::vec2 getJointWeights() const;
+
+    // Cells closer than `clearanceRange` cells to an obstacle pay up to
+    // `clearancePenalty` free moves extra, falling off linearly.
+    void setClearanceRange(int clearanceRange);
+    int getClearanceRange() const;
+
+    void setClearancePenalty(float clearancePenalty);
+    float getClearancePenalty() const;
+
+    void create(const ConfigurationSpace& space);
+    bool isValid(const ConfigurationSpace& space) const;
+    void invalidate();
+
+    float getClearance(glm::ivec2 coord) const;
+    int getStepCost(glm::ivec2 coord, int axis) const;
+    int getMinStepCost(int axis) const;
+    int getMaxStepCost() const;
+
+private:
+    void computeClearance(const ConfigurationSpace& space);
+
+    int getIndex(glm::ivec2 coord) const;
+
+    glm::vec2 _jointWeights;
+    int _clearanceRange;
+    float _clearancePenalty;
+
+    const ConfigurationSpace* _space;
+    unsigned long _spaceRevision;
+    bool _valid;
+
+    int _resolution;
+    int _minStepCost[2];
+    int _maxStepCost;
+    std::vector<float> _clearance;
+    std::vector<std::uint16_t> _stepCosts[2];
+};
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "BucketQueue.hpp"
+#include "CostMap.hpp"
+#include "PathPlanner.hpp"
+
+namespace kinematic
+{
+
+// A* over the step costs of a cost map, so paths keep away from obstacles
+// and favour the cheaper joint. Costs are small integers, so the open set
+// is a bucket queue instead of a heap. The cost map is rebuilt only when
+// the configuration space changes or one of its settings does.
+class CostMapPlanner:
+    public PathPlanner
+{
+public:
+    CostMapPlanner();
+    virtual ~CostMapPlanner();
+
+    virtual bool findPath(
+        const ConfigurationSpace& space,
+        glm::ivec2 start,
+        glm::ivec2 end
+    ) override;
+
+    CostMap& getCostMap();
+    const CostMap& getCostMap() const;
+
+private:
+    int getHeuristic(glm::ivec2 from, glm::ivec2 to) const;
+
+    CostMap _costMap;
+    BucketQueue _openSet;
+};
+
+}
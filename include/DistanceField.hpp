@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "ConfigurationSpace.hpp"
+#include "SearchWorkspace.hpp"
+
+namespace kinematic
+{
+
+// Wavefront distances from one goal cell over the wrapping configuration
+// space. A path from any start in the goal's component is read off by
+// walking down the field, without searching. The field stays valid until
+// the configuration space it was built from changes its revision.
+class DistanceField
+{
+public:
+    static const int cUnreachable;
+
+    DistanceField();
+    ~DistanceField();
+
+    void create(const ConfigurationSpace& space, glm::ivec2 goal);
+    bool isValid(const ConfigurationSpace& space) const;
+    bool isValid(const ConfigurationSpace& space, glm::ivec2 goal) const;
+    void invalidate();
+
+    glm::ivec2 getGoal() const;
+    int getDistance(glm::ivec2 coord) const;
+    int getMaxDistance() const;
+    int getExpandedNodes() const;
+    const std::vector<int>& getDistances() const;
+
+    bool descend(glm::ivec2 start, std::vector<glm::ivec2>& path) const;
+
+private:
+    glm::ivec2 wrap(glm::ivec2 coord) const;
+    int getIndex(glm::ivec2 coord) const;
+
+    const ConfigurationSpace* _space;
+    unsigned long _spaceRevision;
+    bool _valid;
+
+    int _resolution;
+    glm::ivec2 _goal;
+    int _maxDistance;
+    int _expandedNodes;
+    std::vector<int> _distances;
+    SearchWorkspace _workspace;
+};
+
+}
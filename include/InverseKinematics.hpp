@@ -0,0 +1,31 @@
+#pragma once
+
+namespace kinematic
+{
+
+// Caller-owned structure-of-arrays output of solveInverseKinematics, each
+// array holding at least one entry per target. Solution 0 puts the elbow
+// to the left of the line from the base to the target (elbow up for
+// targets on the right), solution 1 to the right. Betas are relative to
+// alpha and wrapped to [-pi, pi].
+struct InverseKinematicsBuffers
+{
+    float* alpha[2];
+    float* beta[2];
+    unsigned char* reachable;
+};
+
+// Solves the two-link arm for `count` targets given as structure of arrays
+// and returns how many are reachable. Unreachable targets, the base among
+// them, get zero angles. Vectorised where the build allows and free of
+// allocations, so dense target grids can be evaluated in one call.
+int solveInverseKinematics(
+    float firstArmLength,
+    float secondArmLength,
+    const float* targetX,
+    const float* targetY,
+    int count,
+    const InverseKinematicsBuffers& output
+);
+
+}
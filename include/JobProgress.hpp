@@ -0,0 +1,30 @@
+#pragma once
+
+#include <atomic>
+
+namespace kinematic
+{
+
+// Shared between work running on another thread and the thread waiting
+// for it. The worker reports how far it got, from zero to one, and polls
+// whether it should stop early.
+class JobProgress
+{
+public:
+    JobProgress();
+    ~JobProgress();
+
+    void reset();
+
+    void setProgress(float progress);
+    float getProgress() const;
+
+    void cancel();
+    bool isCancelled() const;
+
+private:
+    std::atomic<float> _progress;
+    std::atomic<bool> _cancelled;
+};
+
+}
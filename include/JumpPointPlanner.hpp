@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "PathPlanner.hpp"
+
+namespace kinematic
+{
+
+// Jump point search for the 4-connected torus. Horizontal runs follow
+// beta, vertical runs follow alpha; vertical runs may turn into either
+// horizontal direction, horizontal runs only turn where an obstacle
+// corner forces them to.
+class JumpPointPlanner:
+    public PathPlanner
+{
+public:
+    JumpPointPlanner();
+    virtual ~JumpPointPlanner();
+
+    virtual bool findPath(
+        const ConfigurationSpace& space,
+        glm::ivec2 start,
+        glm::ivec2 end
+    ) override;
+
+private:
+    bool isFree(const ConfigurationSpace& space, glm::ivec2 coord) const;
+
+    // Parents and directions are only read for states with a distance.
+    int getStateDistance(int state) const;
+    void setStateDistance(int state, int distance);
+
+    bool hasForcedNeighbour(
+        const ConfigurationSpace& space,
+        glm::ivec2 coord,
+        int diry,
+        int dirx
+    ) const;
+
+    int jumpHorizontal(
+        const ConfigurationSpace& space,
+        glm::ivec2 from,
+        int diry,
+        glm::ivec2 end
+    );
+
+    int jumpVertical(
+        const ConfigurationSpace& space,
+        glm::ivec2 from,
+        int dirx,
+        glm::ivec2 end
+    );
+
+    // Horizontal runs are looked up rather than walked. For each cell and
+    // direction the rows store the steps to the next blocked cell or
+    // forced neighbour, filled a row at a time when first needed and kept
+    // until the space changes.
+    void resetRowStops(const ConfigurationSpace& space);
+    void fillRowStops(const ConfigurationSpace& space, int row);
+    int getRowStopIndex(glm::ivec2 coord, int diry) const;
+
+    void storeJumpPath(int endState);
+
+    std::vector<int> _stateDistance;
+    std::vector<std::uint32_t> _stateStamps;
+    std::vector<int> _stateParent;
+    std::vector<signed char> _stateDirection;
+
+    const ConfigurationSpace* _space;
+    unsigned long _spaceRevision;
+    std::vector<int> _rowStops;
+    std::vector<bool> _rowFilled;
+};
+
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vector>
+
+#include "glm/glm.hpp"
+
+namespace kinematic
+{
+
+// Joint angles of a chain, each relative to the previous link.
+typedef std::vector<float> JointVector;
+
+// Planar chain of revolute joints with its base at the origin.
+class KinematicChain
+{
+public:
+    KinematicChain();
+    ~KinematicChain();
+
+    void setLinkLengths(const std::vector<float>& linkLengths);
+    const std::vector<float>& getLinkLengths() const;
+
+    int getJointCount() const;
+    float getReach() const;
+
+    // Writes getJointCount() + 1 points: the base and the far end of every
+    // link.
+    void computeJointPositions(
+        const float* angles,
+        glm::vec2* positions
+    ) const;
+
+    // Same for `count` configurations at once. Angles are joint-major,
+    // angles[joint * count + i], and so are the outputs, with the base
+    // taking the first `count` entries of `x` and `y`.
+    void computeJointPositions(
+        const float* angles,
+        int count,
+        float* x,
+        float* y
+    ) const;
+
+private:
+    std::vector<float> _linkLengths;
+};
+
+}
@@ -17,8 +17,29 @@
 #include "fw/PolygonalLine.hpp"
 #include "fw/effects/Standard2DEffect.hpp"
 
+#include "AStarPlanner.hpp"
+#include "BackgroundJob.hpp"
+#include "BidirectionalPlanner.hpp"
+#include "BreadthFirstPlanner.hpp"
+#include "ChainConfigurationSpace.hpp"
+#include "ChainPlanner.hpp"
+#include "ConfigurationSpace.hpp"
+#include "CostMapPlanner.hpp"
+#include "DistanceField.hpp"
+#include "JumpPointPlanner.hpp"
+#include "LatticePlanner.hpp"
+#include "LazyPRMPlanner.hpp"
+#include "MultiQueryPlanner.hpp"
+#include "PathPlanner.hpp"
+#include "PathSmoother.hpp"
+#include "QuadBatch.hpp"
+#include "RRTConnectPlanner.hpp"
+#include "ReachabilityMap.hpp"
 #include "RoboticArmController.hpp"
 #include "RoboticArmRendering.hpp"
+#include "ThetaStarPlanner.hpp"
+#include "ThreadPool.hpp"
+#include "Trajectory.hpp"
 
 namespace kinematic
 {
@@ -45,59 +66,98 @@ protected:
 
     glm::vec2 getWorldCursorPos(glm::vec2 screenMousePos) const;
     glm::mat4 getProjection() const;
+    fw::AABB<glm::vec2> getVisibleArea() const;
     bool grabConstraint();
 
-    bool checkArmConstraintCollision(glm::vec2 start, glm::vec2 end) const;
-
-    bool checkSegmentAABBCollision(
-        const glm::vec2& start,
-        const glm::vec2& end,
-        const fw::AABB<glm::vec2>& aabb
-    ) const;
-
     void createAvailabilityMap();
+    void publishAvailabilityMap(std::shared_ptr<ConfigurationSpace> space);
     void createAvailabilityMapTexture();
+    void onConstraintsChanged();
     bool checkConfiguration(float alpha, float beta);
 
     std::vector<std::pair<float, float>> getValidSolutions();
 
 private:
-    void drawQuad(
-        const glm::vec2& position,
-        const glm::vec2& size,
-        const glm::vec3& color
-    );
+    void addArm(const JointVector& angles, const glm::vec4& color);
 
     void showTexturePreview(GLuint texture, int w, int h);
+    void showJobProgress(BackgroundJob& job, const char* cancelLabel);
 
-    glm::ivec2 getClosestInConfiguration(glm::vec2 coord);
-    void markSearchMap(glm::ivec2 coord, int value);
-    int getSearchMapValue(glm::ivec2 coord);
-    bool verifyAvailability(glm::ivec2 coord);
+    void createPathPlanner();
+    void showCostMapSettings();
+    void showReachability();
+    void createReachabilityMap(const fw::AABB<glm::vec2>& area);
+    void createReachabilityTexture();
     void findPath();
-    void trackbackAndStorePath(glm::ivec2 end);
+    void goToEndConfiguration();
+    void createSearchMapTexture(glm::ivec2 start, glm::ivec2 end);
     void updatePolygonalLine();
-
-    float mixDegrees(float a, float b, float m);
+    void updatePathGhosts();
+
+    void syncChainSpace();
+    void createChainPlanner();
+    void showChainPathFinding();
+    void findChainPath();
+    void takePlanningSnapshot();
+    std::shared_ptr<PathSmoother> getActiveSmoother() const;
+    void storeMotionPath(std::vector<JointVector> path);
+    void createTrajectory();
+    float getDisplayStep() const;
+    JointVector getChainPose() const;
+    void resetPaths();
 
     std::shared_ptr<fw::PolygonalLine> _line;
 
     std::shared_ptr<fw::Standard2DEffect> _standard2DEffect;
-    std::shared_ptr<fw::Mesh<fw::StandardVertex2D>> _quadGeometry;
+    std::shared_ptr<QuadBatch> _quadBatch;
+    std::shared_ptr<QuadBatch> _ghostBatch;
     std::shared_ptr<fw::Texture> _testTexture;
 
     std::shared_ptr<RoboticArmController> _armController;
     std::shared_ptr<RoboticArmRendering> _armRendering;
 
+    std::shared_ptr<ThreadPool> _jobThreadPool;
+    std::shared_ptr<BackgroundJob> _mapJob;
+    std::shared_ptr<BackgroundJob> _planningJob;
+    std::shared_ptr<BackgroundJob> _reachabilityJob;
+
+    std::shared_ptr<ConfigurationSpace> _configurationSpace;
+    std::shared_ptr<ConfigurationSpace> _planningSpace;
+    std::shared_ptr<ChainConfigurationSpace> _planningChainSpace;
+    std::shared_ptr<PathPlanner> _pathPlanner;
+    std::shared_ptr<CostMapPlanner> _costMapPlanner;
+    std::shared_ptr<DistanceField> _goalField;
+
+    std::shared_ptr<ChainConfigurationSpace> _chainSpace;
+    std::shared_ptr<ChainPlanner> _chainPlanner;
+    int _chainPlannerKind;
+    int _jointCount;
+    JointVector _chainStart;
+    JointVector _chainEnd;
+    std::vector<JointVector> _chainPath;
+    bool _chainPathFailed;
+
+    std::shared_ptr<PathSmoother> _pathSmoother;
+    bool _pathSmoothingEnabled;
+
     GLuint _texturePreview;
 
+    std::shared_ptr<ReachabilityMap> _reachabilityMap;
+    bool _reachabilityEnabled;
+    GLuint _reachabilityTexture;
+
+    std::shared_ptr<Trajectory> _trajectory;
     bool _animationEnabled;
-    float _frameAnimationPassed;
-    float _frameTime;
-    int _currentAnimationStep;
+    bool _ghostsEnabled;
+    float _animationTime;
+    float _jointVelocityLimit;
+    float _jointAccelerationLimit;
 
     bool _availabilityMapCreated;
     GLuint _availabilityMapTexture;
+    unsigned long _availabilityMapRevision;
+    int _configurationSpaceResolution;
+    int _pathPlannerKind;
 
     bool _searchMapAvailable;
     GLuint _searchMapTexture;
@@ -110,11 +170,6 @@ private:
     glm::vec2 _endConfiguration;
 
     int _selectedConstraint;
-    std::vector<fw::AABB<glm::vec2>> _constraints;
-
-    std::vector<bool> _availabilityMap;
-    std::vector<int> _searchMap;
-    std::vector<glm::ivec2> _searchMapTraceback;
 };
 
 }
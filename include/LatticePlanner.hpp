@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "ChainPlanner.hpp"
+
+namespace kinematic
+{
+
+// A* over a regular lattice of the chain's torus, moving one joint by one
+// step at a time. Lattice points and the moves between them are only
+// checked for collisions when the search first reaches them, so the full
+// grid is never built. The exact start and goal are joined to their
+// nearest lattice points by checked moves.
+class LatticePlanner:
+    public ChainPlanner
+{
+public:
+    static const int cDefaultResolution;
+    static const int cDefaultExpansionLimit;
+    static const float cDefaultCollisionStep;
+
+    LatticePlanner();
+    virtual ~LatticePlanner();
+
+    void setResolution(int resolution);
+    int getResolution() const;
+
+    void setExpansionLimit(int expansionLimit);
+    int getExpansionLimit() const;
+
+    // Workspace distance, as ChainConfigurationSpace::checkMotion takes it.
+    void setCollisionStep(float collisionStep);
+    float getCollisionStep() const;
+
+    virtual bool findPath(
+        const ChainConfigurationSpace& space,
+        const JointVector& start,
+        const JointVector& goal
+    ) override;
+
+private:
+    std::uint64_t encode(const std::vector<int>& steps) const;
+    void decode(std::uint64_t key, std::vector<int>& steps) const;
+    int snap(float angle) const;
+    void getAngles(const std::vector<int>& steps, JointVector& angles) const;
+    int getHeuristic(
+        const std::vector<int>& steps,
+        const std::vector<int>& goal
+    ) const;
+
+    int _resolution;
+    int _expansionLimit;
+    float _collisionStep;
+    int _bitsPerJoint;
+};
+
+}
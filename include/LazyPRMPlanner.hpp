@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "ChainPlanner.hpp"
+#include "TorusKDTree.hpp"
+
+namespace kinematic
+{
+
+// Probabilistic roadmap whose samples and k-nearest edges depend only on
+// the dimension and the seed, so it is built once and reused by every
+// query. Nothing is collision checked up front: each query searches the
+// roadmap, checking nodes as they are reached and the edges of the best
+// candidate path, and searches again without whichever edge was blocked.
+// Results for roadmap nodes and edges are kept for later queries until the
+// space, its revision or the collision step changes.
+class LazyPRMPlanner:
+    public ChainPlanner
+{
+public:
+    static const unsigned cDefaultSeed;
+    static const int cDefaultSampleCount;
+    static const int cDefaultNeighbourCount;
+    static const float cDefaultCollisionStep;
+    static const int cDefaultSearchLimit;
+
+    LazyPRMPlanner();
+    virtual ~LazyPRMPlanner();
+
+    void setSeed(unsigned seed);
+    unsigned getSeed() const;
+
+    void setSampleCount(int sampleCount);
+    int getSampleCount() const;
+
+    void setNeighbourCount(int neighbourCount);
+    int getNeighbourCount() const;
+
+    // Workspace distance, as ChainConfigurationSpace::checkMotion takes it.
+    void setCollisionStep(float collisionStep);
+    float getCollisionStep() const;
+
+    void setSearchLimit(int searchLimit);
+    int getSearchLimit() const;
+
+    virtual bool findPath(
+        const ChainConfigurationSpace& space,
+        const JointVector& start,
+        const JointVector& goal
+    ) override;
+
+private:
+    void buildRoadmap(int dimension);
+    void resetCollisionStates();
+    void connectQuery(const JointVector& start, const JointVector& goal);
+    const float* getPoint(int node) const;
+    void getNeighbours(int node, std::vector<int>& neighbours) const;
+
+    bool searchRoadmap(
+        const ChainConfigurationSpace& space,
+        std::vector<int>& nodes
+    );
+    bool validatePath(
+        const ChainConfigurationSpace& space,
+        const std::vector<int>& nodes
+    );
+
+    std::uint64_t getEdgeKey(int from, int to) const;
+    std::unordered_map<std::uint64_t, bool>& getEdgeStates(int from, int to);
+
+    unsigned _seed;
+    int _sampleCount;
+    int _neighbourCount;
+    float _collisionStep;
+    int _searchLimit;
+
+    bool _roadmapValid;
+    TorusKDTree _roadmap;
+    std::vector<std::vector<int>> _adjacency;
+
+    // Start and goal follow the samples as nodes _sampleCount and
+    // _sampleCount + 1; only they list their edges, the roadmap is shared.
+    std::vector<std::vector<int>> _queryAdjacency;
+    JointVector _queryPoints;
+
+    const ChainConfigurationSpace* _space;
+    unsigned long _spaceRevision;
+    std::vector<signed char> _nodeStates;
+    std::unordered_map<std::uint64_t, bool> _edgeStates;
+    std::unordered_map<std::uint64_t, bool> _queryEdgeStates;
+    std::vector<int> _neighbours;
+};
+
+}
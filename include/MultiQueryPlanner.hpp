@@ -0,0 +1,42 @@
+#pragma once
+
+#include "ConnectedComponents.hpp"
+#include "DistanceField.hpp"
+#include "PathPlanner.hpp"
+
+namespace kinematic
+{
+
+// Answers many queries against one configuration space. Free space is
+// labelled once per map revision so that queries between different
+// components fail immediately, and the distance field of the last goal is
+// kept so that repeated goals only need a descent from the new start.
+class MultiQueryPlanner:
+    public PathPlanner
+{
+public:
+    MultiQueryPlanner();
+    virtual ~MultiQueryPlanner();
+
+    virtual bool findPath(
+        const ConfigurationSpace& space,
+        glm::ivec2 start,
+        glm::ivec2 end
+    ) override;
+
+    // Reads the goal's distance field rather than copying it per query.
+    virtual int getSearchMapState(glm::ivec2 coord) const override;
+
+    const ConnectedComponents& getComponents() const;
+
+private:
+    void updateComponents(const ConfigurationSpace& space);
+
+    const ConfigurationSpace* _space;
+    unsigned long _spaceRevision;
+    ConnectedComponents _components;
+    DistanceField _goalField;
+    bool _goalFieldShown;
+};
+
+}
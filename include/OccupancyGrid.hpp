@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "AlignedAllocator.hpp"
+
+namespace kinematic
+{
+
+// Bit per cell, set when the cell is occupied. The storage starts on a
+// cache line and rows are padded to whole lines, so they can be written
+// from different threads. The padding bits past the last column read as
+// occupied.
+class OccupancyGrid
+{
+public:
+    static const int cBitsPerWord = 64;
+    static const int cCacheLineSize = 64;
+
+    OccupancyGrid();
+    OccupancyGrid(int rows, int columns);
+    ~OccupancyGrid();
+
+    void resize(int rows, int columns);
+
+    int getRows() const;
+    int getColumns() const;
+    int getWordsPerRow() const;
+
+    bool isOccupied(int row, int column) const;
+    void setOccupied(int row, int column, bool occupied);
+    void setOccupied(int row, int firstColumn, int lastColumn, bool occupied);
+    void fill(bool occupied);
+
+    int countOccupied() const;
+
+    const std::uint64_t* getRow(int row) const;
+    std::uint64_t* getRow(int row);
+
+private:
+    void maskPadding(int row);
+
+    int _rows, _columns, _wordsPerRow;
+    std::vector<
+        std::uint64_t,
+        AlignedAllocator<std::uint64_t, cCacheLineSize>
+    > _words;
+};
+
+}
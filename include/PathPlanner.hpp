@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "ConfigurationSpace.hpp"
+
+namespace kinematic
+{
+
+class PathPlanner
+{
+public:
+    static const int cSearchMapUnvisited;
+
+    PathPlanner();
+    virtual ~PathPlanner();
+
+    virtual bool findPath(
+        const ConfigurationSpace& space,
+        glm::ivec2 start,
+        glm::ivec2 end
+    ) = 0;
+
+    void setSearchMapRecording(bool enabled);
+    bool isSearchMapRecording() const;
+
+    const std::vector<glm::ivec2>& getPath() const;
+    // Value the last search left in a cell, cSearchMapUnvisited if none.
+    virtual int getSearchMapState(glm::ivec2 coord) const;
+    int getMaxDistance() const;
+    int getExpandedNodes() const;
+
+protected:
+    // Per-cell storage is stamped with a search generation instead of
+    // being cleared, so these only size it; cells stamped by an earlier
+    // search read as unset.
+    void resetSearch(int resolution);
+    void resetSearchMap();
+    void resetTraceback();
+
+    glm::ivec2 wrap(glm::ivec2 coord) const;
+    int getIndex(glm::ivec2 coord) const;
+    int getTorusDistance(glm::ivec2 from, glm::ivec2 to) const;
+
+    void markSearchMap(glm::ivec2 coord, int value);
+    int getSearchMapValue(glm::ivec2 coord) const;
+    void setTraceback(int index, glm::ivec2 parent);
+    glm::ivec2 getTraceback(int index) const;
+    void trackbackAndStorePath(glm::ivec2 end);
+
+    void resetStamps(std::vector<std::uint32_t>& stamps, int count) const;
+
+    bool _searchMapRecording;
+
+    int _resolution;
+    int _maxDistance;
+    int _expandedNodes;
+
+    std::uint32_t _searchGeneration;
+    std::vector<int> _searchMap;
+    std::vector<std::uint32_t> _searchMapStamps;
+    std::vector<glm::ivec2> _searchMapTraceback;
+    std::vector<std::uint32_t> _tracebackStamps;
+    std::vector<glm::ivec2> _path;
+};
+
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <random>
+#include <vector>
+
+#include "ChainConfigurationSpace.hpp"
+
+namespace kinematic
+{
+
+// Shortens planned paths. Waypoints that a straight move on the torus can
+// skip are dropped first, random shortcuts follow, and corners are then
+// cut wherever the cut stays free. Every change is verified by walking
+// the new move, and the number of such walks is capped so that smoothing
+// stays cheap enough for the UI thread.
+class PathSmoother
+{
+public:
+    static const unsigned cDefaultSeed;
+    static const int cDefaultIterationLimit;
+    static const int cDefaultShortcutCount;
+    static const int cDefaultSmoothingPasses;
+    static const float cDefaultCollisionStep;
+
+    PathSmoother();
+    ~PathSmoother();
+
+    void setSeed(unsigned seed);
+    unsigned getSeed() const;
+
+    void setIterationLimit(int iterationLimit);
+    int getIterationLimit() const;
+
+    void setShortcutCount(int shortcutCount);
+    int getShortcutCount() const;
+
+    void setSmoothingPasses(int smoothingPasses);
+    int getSmoothingPasses() const;
+
+    // Passed on to ChainConfigurationSpace::checkMotion.
+    void setCollisionStep(float collisionStep);
+    float getCollisionStep() const;
+
+    // The path must be free; it stays free and never gets longer.
+    void smooth(
+        const ChainConfigurationSpace& space,
+        std::vector<JointVector>& path
+    );
+
+    int getMotionChecks() const;
+
+    // Splits every move so that no joint turns by more than `maxStep`
+    // between consecutive configurations.
+    static std::vector<JointVector> resample(
+        const std::vector<JointVector>& path,
+        float maxStep
+    );
+
+private:
+    bool checkMotion(
+        const ChainConfigurationSpace& space,
+        const JointVector& from,
+        const JointVector& to
+    );
+
+    void pruneWaypoints(
+        const ChainConfigurationSpace& space,
+        std::vector<JointVector>& path
+    );
+
+    void shortcutPath(
+        const ChainConfigurationSpace& space,
+        std::vector<JointVector>& path
+    );
+
+    void cutCorners(
+        const ChainConfigurationSpace& space,
+        std::vector<JointVector>& path
+    );
+
+    bool hasBudget() const;
+
+    static JointVector interpolate(
+        const JointVector& from,
+        const JointVector& to,
+        float t
+    );
+
+    unsigned _seed;
+    int _iterationLimit;
+    int _shortcutCount;
+    int _smoothingPasses;
+    float _collisionStep;
+
+    int _motionChecks;
+    std::mt19937 _random;
+    std::vector<JointVector> _buffer;
+};
+
+}
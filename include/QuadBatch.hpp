@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "fw/Mesh.hpp"
+
+namespace kinematic
+{
+
+// One quad of a QuadBatch: a unit square scaled to `size`, with its x
+// axis turned to the unit vector `direction`, centred at `position`.
+struct QuadInstance
+{
+    glm::vec2 position;
+    glm::vec2 size;
+    glm::vec2 direction;
+    glm::vec4 color;
+};
+
+// Draws flat-coloured quads with a single instanced call. Quads are kept
+// in one per-instance buffer, uploaded again only after they change, and
+// drawn in the order they were added, blended by their alpha.
+class QuadBatch
+{
+public:
+    QuadBatch();
+    ~QuadBatch();
+
+    // GL objects need a current context, so they are made and released
+    // explicitly rather than with the batch.
+    void create();
+    void destroy();
+
+    void clear();
+    void add(const QuadInstance& instance);
+    void addQuad(glm::vec2 position, glm::vec2 size, glm::vec4 color);
+    void addSegment(
+        glm::vec2 start,
+        glm::vec2 end,
+        float thickness,
+        glm::vec4 color
+    );
+
+    int size() const;
+
+    void render(const glm::mat4& projection);
+
+private:
+    std::vector<QuadInstance> _instances;
+    bool _changed;
+
+    GLuint _program;
+    GLint _projectionLocation;
+    GLuint _vertexArray;
+    GLuint _cornerBuffer;
+    GLuint _instanceBuffer;
+};
+
+}
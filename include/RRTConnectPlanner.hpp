@@ -0,0 +1,73 @@
+#pragma once
+
+#include <random>
+#include <vector>
+
+#include "ChainPlanner.hpp"
+#include "TorusKDTree.hpp"
+
+namespace kinematic
+{
+
+// Bidirectional rapidly-exploring random trees grown from the start and
+// the goal until they meet. Each tree keeps a torus k-d tree for nearest
+// neighbour lookups; edges are checked by walking them before a node is
+// added. The same seed gives the same path.
+class RRTConnectPlanner:
+    public ChainPlanner
+{
+public:
+    static const unsigned cDefaultSeed;
+    static const int cDefaultIterationLimit;
+    static const float cDefaultStepSize;
+    static const float cDefaultCollisionStep;
+
+    RRTConnectPlanner();
+    virtual ~RRTConnectPlanner();
+
+    void setSeed(unsigned seed);
+    unsigned getSeed() const;
+
+    void setIterationLimit(int iterationLimit);
+    int getIterationLimit() const;
+
+    void setStepSize(float stepSize);
+    float getStepSize() const;
+
+    // Largest workspace distance any point of the chain may travel
+    // between two configurations checked along an edge.
+    void setCollisionStep(float collisionStep);
+    float getCollisionStep() const;
+
+    virtual bool findPath(
+        const ChainConfigurationSpace& space,
+        const JointVector& start,
+        const JointVector& goal
+    ) override;
+
+private:
+    struct Tree
+    {
+        TorusKDTree index;
+        std::vector<int> parents;
+    };
+
+    int extend(
+        const ChainConfigurationSpace& space,
+        Tree& tree,
+        const float* target,
+        bool& reached
+    );
+
+    void appendBranch(const Tree& tree, int node, bool towardsRoot);
+
+    unsigned _seed;
+    int _iterationLimit;
+    float _stepSize;
+    float _collisionStep;
+
+    Tree _trees[2];
+    JointVector _extension;
+};
+
+}
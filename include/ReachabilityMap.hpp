@@ -0,0 +1,76 @@
+#pragma once
+
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "fw/AABB.hpp"
+
+#include "ConfigurationSpace.hpp"
+#include "ConnectedComponents.hpp"
+#include "JobProgress.hpp"
+
+namespace kinematic
+{
+
+// Raster over a rectangle of the workspace recording, for every sample,
+// how many collision-free inverse kinematics solutions reach it and
+// whether both lie in one component of the configuration space, so that
+// the arm can switch between them without leaving free space. Components
+// come from the availability map and count as unknown, so not connected,
+// while it is missing. Built in parallel tiles, the raster stays valid
+// until the obstacles, the arm, the area or the resolution change; a copy
+// of the space it was built from finds it valid as well.
+class ReachabilityMap
+{
+public:
+    static const int cDefaultColumns;
+    static const int cDefaultRows;
+
+    ReachabilityMap();
+    ~ReachabilityMap();
+
+    void setResolution(int columns, int rows);
+    int getColumns() const;
+    int getRows() const;
+
+    // Reports the share of tiles done and stops early, returning false and
+    // leaving an invalid map, once `progress` gets cancelled.
+    bool create(
+        const ConfigurationSpace& space,
+        const fw::AABB<glm::vec2>& area,
+        JobProgress* progress = nullptr
+    );
+
+    bool isValid(
+        const ConfigurationSpace& space,
+        const fw::AABB<glm::vec2>& area
+    ) const;
+
+    void invalidate();
+
+    // Row 0 lies along the bottom edge of the area.
+    glm::vec2 getSamplePosition(int column, int row) const;
+    int getSolutionCount(int column, int row) const;
+    bool areSolutionsConnected(int column, int row) const;
+
+private:
+    void updateComponents(const ConfigurationSpace& space);
+    void createTile(const ConfigurationSpace& space, int tile);
+
+    int _columns, _rows;
+
+    float _firstArmLength, _secondArmLength;
+    std::vector<fw::AABB<glm::vec2>> _constraints;
+    fw::AABB<glm::vec2> _area;
+    bool _valid;
+
+    ConnectedComponents _components;
+    unsigned long _componentsRevision;
+    bool _componentsValid;
+
+    std::vector<unsigned char> _solutionCounts;
+    std::vector<unsigned char> _connected;
+};
+
+}
@@ -5,6 +5,9 @@
 #include <vector>
 #include "glm/glm.hpp"
 
+#include "InverseKinematics.hpp"
+#include "KinematicChain.hpp"
+
 namespace kinematic
 {
 
@@ -20,6 +23,11 @@ public:
 
     const std::vector<std::pair<float, float>>& getSolutions() const;
 
+    int getJointCount() const;
+    KinematicChain getChain() const;
+    JointVector getJointAngles() const;
+    void setJointAngles(const JointVector& angles);
+
     float getFirstArmLength() const;
     float getSecondArmLength() const;
 
@@ -29,13 +37,23 @@ public:
     std::pair<glm::vec2, glm::vec2> buildConfiguration(float alpha, float beta);
     bool solveInverseKinematics();
 
+    // Solves many targets for the first two links at once, see
+    // kinematic::solveInverseKinematics; the controller is left as is.
+    int solveInverseKinematics(
+        const float* targetX,
+        const float* targetY,
+        int count,
+        const InverseKinematicsBuffers& output
+    ) const;
+
     void swapSolutions();
 
 private:
     glm::vec2 _ikTarget;
     glm::vec2 _ikSecondTarget;
 
-    float _firstArmLength, _secondArmLength;
+    std::vector<float> _linkLengths;
+    JointVector _jointAngles;
     std::vector<std::pair<float, float>> _solutions;
 
     float _thickness;
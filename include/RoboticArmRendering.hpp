@@ -1,10 +1,8 @@
 #pragma once
 
-#include <memory>
 #include <vector>
-#include "fw/GeometryChunk.hpp"
-#include "fw/Mesh.hpp"
-#include "fw/Vertices.hpp"
+#include "KinematicChain.hpp"
+#include "QuadBatch.hpp"
 
 namespace kinematic
 {
@@ -16,19 +14,28 @@ public:
     ~RoboticArmRendering();
 
     void setArmsThickness(float thickness);
-    void setFirstArmLength(float length);
-    void setSecondArmLength(float length);
+    void setChain(const KinematicChain& chain);
+    void setJointAngles(const JointVector& angles);
 
-    void setAlphaAngle(float alphaAngle);
-    void setBetaAngle(float betaAngle);
+    // Adds one quad per link.
+    void render(QuadBatch& batch, const glm::vec4& color);
 
-    std::vector<fw::GeometryChunk> render();
+    // Adds the links of every pose along the path, coloured from
+    // `firstColor` at its start to `lastColor` at its end.
+    void renderPath(
+        QuadBatch& batch,
+        const std::vector<JointVector>& path,
+        const glm::vec4& firstColor,
+        const glm::vec4& lastColor
+    );
 
 private:
     float _armsThickness;
-    float _firstArmLength, _secondArmLength;
-    float _alphaAngle, _betaAngle;
-    std::shared_ptr<fw::Mesh<fw::StandardVertex2D>> _quad;
+    KinematicChain _chain;
+    JointVector _jointAngles;
+    std::vector<glm::vec2> _jointPositions;
+    std::vector<float> _pathAngles;
+    std::vector<float> _pathX, _pathY;
 };
 
 }
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace kinematic
+{
+
+// Scratch memory for grid searches that is kept between queries. Visited
+// marks are stamped with a generation counter, so starting a new search
+// does not clear anything, and parents are stored as one of four move
+// directions packed into two bits per cell.
+class SearchWorkspace
+{
+public:
+    SearchWorkspace();
+    ~SearchWorkspace();
+
+    void reset(int cellCount);
+
+    bool isVisited(std::uint32_t cell) const;
+    void visit(std::uint32_t cell, int direction);
+    int getDirection(std::uint32_t cell) const;
+
+    bool isFrontierEmpty() const;
+    void pushFrontier(std::uint32_t cell);
+    std::uint32_t popFrontier();
+    std::uint32_t getFrontierSize() const;
+
+private:
+    int _cellCount;
+    std::uint32_t _generation;
+    std::vector<std::uint32_t> _visitedGeneration;
+    std::vector<std::uint8_t> _directions;
+
+    std::vector<std::uint32_t> _frontier;
+    std::uint32_t _frontierMask;
+    std::uint32_t _frontierHead;
+    std::uint32_t _frontierTail;
+};
+
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define KINEMATIC_SIMD_AVX
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define KINEMATIC_SIMD_SSE
+#endif
+
+#if defined(KINEMATIC_SIMD_AVX) || defined(KINEMATIC_SIMD_SSE)
+#define KINEMATIC_SIMD
+#endif
+
+namespace kinematic
+{
+
+// The widest float vectors the build targets, wrapped so that kernels are
+// written once for AVX and SSE2. Without either, cLanes is 1 and kernels
+// fall back to their scalar loops. Comparisons yield lane masks usable by
+// both(), blend() and mask().
+namespace simd
+{
+
+#if defined(KINEMATIC_SIMD_AVX)
+
+typedef __m256 Lanes;
+const int cLanes = 8;
+
+inline Lanes load(const float* p) { return _mm256_loadu_ps(p); }
+inline void store(float* p, Lanes a) { _mm256_storeu_ps(p, a); }
+inline Lanes broadcast(float v) { return _mm256_set1_ps(v); }
+inline Lanes add(Lanes a, Lanes b) { return _mm256_add_ps(a, b); }
+inline Lanes sub(Lanes a, Lanes b) { return _mm256_sub_ps(a, b); }
+inline Lanes mul(Lanes a, Lanes b) { return _mm256_mul_ps(a, b); }
+inline Lanes divide(Lanes a, Lanes b) { return _mm256_div_ps(a, b); }
+inline Lanes squareRoot(Lanes a) { return _mm256_sqrt_ps(a); }
+inline Lanes minimum(Lanes a, Lanes b) { return _mm256_min_ps(a, b); }
+inline Lanes maximum(Lanes a, Lanes b) { return _mm256_max_ps(a, b); }
+inline Lanes both(Lanes a, Lanes b) { return _mm256_and_ps(a, b); }
+inline Lanes less(Lanes a, Lanes b)
+{
+    return _mm256_cmp_ps(a, b, _CMP_LT_OQ);
+}
+inline Lanes lessEqual(Lanes a, Lanes b)
+{
+    return _mm256_cmp_ps(a, b, _CMP_LE_OQ);
+}
+inline Lanes blend(Lanes condition, Lanes a, Lanes b)
+{
+    return _mm256_blendv_ps(b, a, condition);
+}
+inline Lanes absolute(Lanes a)
+{
+    return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a);
+}
+inline Lanes copySign(Lanes a, Lanes sign)
+{
+    auto signBit = _mm256_set1_ps(-0.0f);
+    return _mm256_or_ps(
+        _mm256_andnot_ps(signBit, a),
+        _mm256_and_ps(signBit, sign)
+    );
+}
+inline int mask(Lanes a) { return _mm256_movemask_ps(a); }
+
+#elif defined(KINEMATIC_SIMD_SSE)
+
+typedef __m128 Lanes;
+const int cLanes = 4;
+
+inline Lanes load(const float* p) { return _mm_loadu_ps(p); }
+inline void store(float* p, Lanes a) { _mm_storeu_ps(p, a); }
+inline Lanes broadcast(float v) { return _mm_set1_ps(v); }
+inline Lanes add(Lanes a, Lanes b) { return _mm_add_ps(a, b); }
+inline Lanes sub(Lanes a, Lanes b) { return _mm_sub_ps(a, b); }
+inline Lanes mul(Lanes a, Lanes b) { return _mm_mul_ps(a, b); }
+inline Lanes divide(Lanes a, Lanes b) { return _mm_div_ps(a, b); }
+inline Lanes squareRoot(Lanes a) { return _mm_sqrt_ps(a); }
+inline Lanes minimum(Lanes a, Lanes b) { return _mm_min_ps(a, b); }
+inline Lanes maximum(Lanes a, Lanes b) { return _mm_max_ps(a, b); }
+inline Lanes both(Lanes a, Lanes b) { return _mm_and_ps(a, b); }
+inline Lanes less(Lanes a, Lanes b) { return _mm_cmplt_ps(a, b); }
+inline Lanes lessEqual(Lanes a, Lanes b) { return _mm_cmple_ps(a, b); }
+inline Lanes blend(Lanes condition, Lanes a, Lanes b)
+{
+    return _mm_or_ps(_mm_and_ps(condition, a), _mm_andnot_ps(condition, b));
+}
+inline Lanes absolute(Lanes a)
+{
+    return _mm_andnot_ps(_mm_set1_ps(-0.0f), a);
+}
+inline Lanes copySign(Lanes a, Lanes sign)
+{
+    auto signBit = _mm_set1_ps(-0.0f);
+    return _mm_or_ps(_mm_andnot_ps(signBit, a), _mm_and_ps(signBit, sign));
+}
+inline int mask(Lanes a) { return _mm_movemask_ps(a); }
+
+#else
+
+const int cLanes = 1;
+
+#endif
+
+}
+
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "ConnectedComponents.hpp"
+#include "PathPlanner.hpp"
+
+namespace kinematic
+{
+
+// A* over eight neighbours on the wrapping grid, with moves costed by the
+// joint travel they need, so a diagonal step turning both joints costs
+// sqrt(2) rather than two axis steps. Diagonals may not squeeze between
+// two blocked cells. With any-angle search enabled a cell may take its
+// parent's parent when the straight line between them is free (Lazy
+// Theta*: the line is only traced when the cell is expanded), and the
+// path comes out as a few corner cells joined by straight moves.
+//
+// Without squeezing, eight neighbours connect the same cells as four, so
+// free space is labelled once per map revision and queries between
+// different components fail without a search.
+class ThetaStarPlanner:
+    public PathPlanner
+{
+public:
+    static const int cDefaultSightLimit;
+
+    ThetaStarPlanner();
+    virtual ~ThetaStarPlanner();
+
+    void setAnyAngle(bool anyAngle);
+    bool isAnyAngle() const;
+
+    // Longest straight move, in cells along either axis, that a cell may
+    // take to its parent's parent. Bounds every line traced on expansion.
+    void setSightLimit(int sightLimit);
+    int getSightLimit() const;
+
+    virtual bool findPath(
+        const ConfigurationSpace& space,
+        glm::ivec2 start,
+        glm::ivec2 end
+    ) override;
+
+private:
+    void updateComponents(const ConfigurationSpace& space);
+
+    bool canMove(
+        const ConfigurationSpace& space,
+        glm::ivec2 from,
+        int direction
+    ) const;
+
+    bool hasLineOfSight(
+        const ConfigurationSpace& space,
+        glm::ivec2 from,
+        glm::ivec2 to
+    ) const;
+
+    void updateParent(
+        const ConfigurationSpace& space,
+        glm::ivec2 current
+    );
+
+    float getCost(int index) const;
+    void setCost(int index, float cost);
+    bool isClosed(int index) const;
+
+    glm::ivec2 getTorusOffset(glm::ivec2 from, glm::ivec2 to) const;
+    float getTravel(glm::ivec2 from, glm::ivec2 to) const;
+    float getHeuristic(glm::ivec2 from, glm::ivec2 to) const;
+
+    bool _anyAngle;
+    int _sightLimit;
+
+    const ConfigurationSpace* _space;
+    unsigned long _spaceRevision;
+    ConnectedComponents _components;
+
+    std::vector<float> _costs;
+    std::vector<std::uint32_t> _costStamps;
+    std::vector<std::uint32_t> _closedStamps;
+};
+
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace kinematic
+{
+
+class ThreadPool
+{
+public:
+    explicit ThreadPool(unsigned int threadCount = 0);
+    ~ThreadPool();
+
+    static std::shared_ptr<ThreadPool> getShared();
+
+    unsigned int getThreadCount() const;
+
+    void parallelFor(
+        int begin,
+        int end,
+        int grainSize,
+        const std::function<void(int, int)>& body
+    );
+
+private:
+    void workerLoop();
+    void runChunks();
+
+    std::vector<std::thread> _workers;
+
+    std::mutex _submitMutex;
+    std::mutex _mutex;
+    std::condition_variable _jobAvailable;
+    std::condition_variable _jobFinished;
+
+    const std::function<void(int, int)>* _body;
+    int _begin, _end, _grainSize, _chunkCount;
+    std::atomic<int> _nextChunk;
+    unsigned long _generation;
+    int _activeWorkers;
+    bool _stopping;
+};
+
+}
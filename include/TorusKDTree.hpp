@@ -0,0 +1,70 @@
+#pragma once
+
+#include <vector>
+
+namespace kinematic
+{
+
+// Incremental k-d tree over points of the torus [0, 2pi)^N, with distance
+// measured as the sum of shortest per-axis angle differences (the same
+// metric as ChainConfigurationSpace::getDistance). Subtrees are pruned by
+// how far their wrapped bounding box lies from the query. Queries reuse
+// buffers kept in the tree, so they do not allocate once warmed up.
+class TorusKDTree
+{
+public:
+    TorusKDTree();
+    ~TorusKDTree();
+
+    void reset(int dimension);
+    int getDimension() const;
+    int size() const;
+
+    int insert(const float* point);
+    const float* getPoint(int index) const;
+
+    int findNearest(const float* query);
+    void findNearest(
+        const float* query,
+        int count,
+        std::vector<int>& indices
+    );
+
+private:
+    struct Node
+    {
+        int left, right;
+    };
+
+    struct Candidate
+    {
+        float distance;
+        int index;
+
+        bool operator<(const Candidate& other) const
+        {
+            return distance < other.distance;
+        }
+    };
+
+    float getDistance(const float* a, const float* b) const;
+    float getAxisDistance(float value, float low, float high) const;
+
+    void search(
+        int node,
+        int depth,
+        const float* query,
+        float bound,
+        int count
+    );
+
+    int _dimension;
+    std::vector<float> _points;
+    std::vector<Node> _nodes;
+
+    std::vector<float> _low, _high;
+    std::vector<Candidate> _best;
+    std::vector<int> _nearest;
+};
+
+}
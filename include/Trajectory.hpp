@@ -0,0 +1,73 @@
+#pragma once
+
+#include <vector>
+
+#include "KinematicChain.hpp"
+
+namespace kinematic
+{
+
+// Fastest timing of a joint path under per-joint velocity and acceleration
+// limits, following the path exactly. The path is cut into short pieces
+// and the squared path speed is chosen per piece as in TOPP-RA: a backward
+// pass bounds the speed from which the end can still be reached at rest,
+// and a forward pass then accelerates as hard as the limits and that bound
+// allow. Sharp corners are therefore taken slowly. Sampling at a time is a
+// binary search over the pieces.
+class Trajectory
+{
+public:
+    static const float cDefaultVelocityLimit;
+    static const float cDefaultAccelerationLimit;
+    static const float cDefaultGridStep;
+
+    Trajectory();
+    ~Trajectory();
+
+    // Joints without a limit of their own use the defaults.
+    void setVelocityLimits(const JointVector& velocityLimits);
+    const JointVector& getVelocityLimits() const;
+
+    void setAccelerationLimits(const JointVector& accelerationLimits);
+    const JointVector& getAccelerationLimits() const;
+
+    void setGridStep(float gridStep);
+    float getGridStep() const;
+
+    void create(const std::vector<JointVector>& path);
+    void clear();
+
+    bool isEmpty() const;
+    float getDuration() const;
+    void sample(float time, JointVector& angles) const;
+
+private:
+    bool getAccelerationRange(
+        int point,
+        float squaredSpeed,
+        float& lowest,
+        float& highest
+    ) const;
+
+    float getMaxSquaredSpeed(int point) const;
+    float getBackwardSquaredSpeed(int point, float nextSquaredSpeed) const;
+
+    JointVector _velocityLimits;
+    JointVector _accelerationLimits;
+    float _gridStep;
+
+    int _dimension;
+    JointVector _jointVelocityLimits;
+    JointVector _jointAccelerationLimits;
+
+    std::vector<JointVector> _points;
+    std::vector<float> _lengths;
+    std::vector<float> _firstDerivatives;
+    std::vector<float> _secondDerivatives;
+
+    std::vector<float> _speeds;
+    std::vector<float> _accelerations;
+    std::vector<float> _times;
+};
+
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <vector>
+
+namespace kinematic
+{
+
+// Sines and cosines of every cell angle of a configuration space grid.
+class TrigonometryTable
+{
+public:
+    TrigonometryTable();
+    ~TrigonometryTable();
+
+    void create(int resolution);
+    int getResolution() const;
+
+    float getCos(int step) const { return _cosines[step]; }
+    float getSin(int step) const { return _sines[step]; }
+
+private:
+    int _resolution;
+    std::vector<float> _cosines;
+    std::vector<float> _sines;
+};
+
+}
@@ -0,0 +1,110 @@
+#include "AStarPlanner.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+namespace kinematic
+{
+
+namespace
+{
+    struct OpenNode
+    {
+        int estimate;
+        int heuristic;
+        int index;
+
+        bool operator>(const OpenNode& other) const
+        {
+            if (estimate != other.estimate)
+            {
+                return estimate > other.estimate;
+            }
+
+            return heuristic > other.heuristic;
+        }
+    };
+}
+
+AStarPlanner::AStarPlanner()
+{
+}
+
+AStarPlanner::~AStarPlanner()
+{
+}
+
+bool AStarPlanner::findPath(
+    const ConfigurationSpace& space,
+    glm::ivec2 start,
+    glm::ivec2 end
+)
+{
+    resetSearch(space.getResolution());
+    resetSearchMap();
+    resetTraceback();
+
+    std::priority_queue<
+        OpenNode,
+        std::vector<OpenNode>,
+        std::greater<OpenNode>
+    > openSet;
+
+    auto startHeuristic = getTorusDistance(start, end);
+    openSet.push({startHeuristic, startHeuristic, getIndex(start)});
+    markSearchMap(start, 0);
+
+    const int dirx[] = {-1, 0, +1, 0};
+    const int diry[] = {0, -1, 0, +1};
+
+    bool found = false;
+    while (!openSet.empty())
+    {
+        auto node = openSet.top();
+        openSet.pop();
+
+        glm::ivec2 current{node.index / _resolution, node.index % _resolution};
+        auto distance = getSearchMapValue(current);
+
+        // The torus distance is consistent, so an entry whose cost was
+        // improved after it got queued can simply be skipped.
+        if (node.estimate - node.heuristic != distance) { continue; }
+
+        if (current == end)
+        {
+            found = true;
+            break;
+        }
+
+        ++_expandedNodes;
+        int nextDist = distance + 1;
+        _maxDistance = std::max(_maxDistance, nextDist);
+
+        for (auto i = 0; i < 4; ++i)
+        {
+            auto next = wrap({current.x + dirx[i], current.y + diry[i]});
+
+            if (!space.verifyAvailability(next)) { continue; }
+
+            auto nextCurrentValue = getSearchMapValue(next);
+            if (nextCurrentValue == cSearchMapUnvisited
+                || nextCurrentValue > nextDist)
+            {
+                auto heuristic = getTorusDistance(next, end);
+                setTraceback(getIndex(next), current);
+                markSearchMap(next, nextDist);
+                openSet.push({nextDist + heuristic, heuristic, getIndex(next)});
+            }
+        }
+    }
+
+    if (found)
+    {
+        trackbackAndStorePath(end);
+    }
+
+    return found;
+}
+
+}
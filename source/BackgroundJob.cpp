@@ -0,0 +1,90 @@
+#include "BackgroundJob.hpp"
+
+#include <utility>
+
+namespace kinematic
+{
+
+BackgroundJob::BackgroundJob():
+    _done{false},
+    _succeeded{false}
+{
+}
+
+BackgroundJob::~BackgroundJob()
+{
+    stop();
+}
+
+void BackgroundJob::start(
+    std::function<bool(JobProgress&)> work,
+    std::function<void()> finish
+)
+{
+    stop();
+
+    _progress.reset();
+    _finish = std::move(finish);
+    _done = false;
+    _succeeded = false;
+
+    // The result flag is written before the release store to _done, so
+    // poll() sees it once it sees the work done.
+    _thread = std::thread([this, work]()
+    {
+        _succeeded = work(_progress);
+        _done = true;
+    });
+}
+
+void BackgroundJob::cancel()
+{
+    _progress.cancel();
+}
+
+bool BackgroundJob::poll()
+{
+    if (!_thread.joinable() || !_done)
+    {
+        return false;
+    }
+
+    _thread.join();
+
+    auto finish = std::move(_finish);
+    _finish = nullptr;
+
+    if (!_succeeded || _progress.isCancelled())
+    {
+        return false;
+    }
+
+    finish();
+    return true;
+}
+
+bool BackgroundJob::isRunning() const
+{
+    return _thread.joinable();
+}
+
+bool BackgroundJob::isCancelled() const
+{
+    return _progress.isCancelled();
+}
+
+float BackgroundJob::getProgress() const
+{
+    return _progress.getProgress();
+}
+
+void BackgroundJob::stop()
+{
+    if (_thread.joinable())
+    {
+        _progress.cancel();
+        _thread.join();
+    }
+}
+
+}
@@ -0,0 +1,187 @@
+#include "BidirectionalPlanner.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace kinematic
+{
+
+BidirectionalPlanner::BidirectionalPlanner()
+{
+}
+
+BidirectionalPlanner::~BidirectionalPlanner()
+{
+}
+
+bool BidirectionalPlanner::findPath(
+    const ConfigurationSpace& space,
+    glm::ivec2 start,
+    glm::ivec2 end
+)
+{
+    resetSearch(space.getResolution());
+    resetSearchMap();
+    resetTraceback();
+
+    const int cellCount = _resolution * _resolution;
+    _reverseSearchMap.resize(cellCount);
+    _reverseSearchMapTraceback.resize(cellCount);
+    resetStamps(_reverseStamps, cellCount);
+
+    visit(true, getIndex(start), 0, glm::ivec2{-1, -1});
+    visit(false, getIndex(end), 0, glm::ivec2{-1, -1});
+
+    if (start == end)
+    {
+        _path.push_back(start);
+        return true;
+    }
+
+    _forwardFrontier.assign(1, start);
+    _backwardFrontier.assign(1, end);
+
+    const int dirx[] = {-1, 0, +1, 0};
+    const int diry[] = {0, -1, 0, +1};
+
+    auto bestLength = -1;
+    glm::ivec2 forwardMeet, backwardMeet;
+
+    // Whole levels are expanded at a time, always on the smaller side, so
+    // the shortest connection seen while finishing the level where the
+    // fronts first touch is the shortest path overall.
+    while (bestLength < 0
+        && !_forwardFrontier.empty()
+        && !_backwardFrontier.empty())
+    {
+        auto forward = _forwardFrontier.size() <= _backwardFrontier.size();
+        auto& frontier = forward ? _forwardFrontier : _backwardFrontier;
+
+        _nextFrontier.clear();
+        for (const auto& current: frontier)
+        {
+            ++_expandedNodes;
+            int nextDist = getDistance(forward, getIndex(current)) + 1;
+            _maxDistance = std::max(_maxDistance, nextDist);
+
+            for (auto i = 0; i < 4; ++i)
+            {
+                auto next = wrap({current.x + dirx[i], current.y + diry[i]});
+
+                if (!space.verifyAvailability(next)) { continue; }
+
+                auto index = getIndex(next);
+                auto otherDist = getDistance(!forward, index);
+                if (otherDist != cSearchMapUnvisited)
+                {
+                    auto length = nextDist + otherDist;
+                    if (bestLength < 0 || length < bestLength)
+                    {
+                        bestLength = length;
+                        forwardMeet = forward ? current : next;
+                        backwardMeet = forward ? next : current;
+                    }
+                }
+
+                if (getDistance(forward, index) == cSearchMapUnvisited)
+                {
+                    visit(forward, index, nextDist, current);
+                    _nextFrontier.push_back(next);
+                }
+            }
+        }
+
+        frontier.swap(_nextFrontier);
+    }
+
+    if (bestLength < 0)
+    {
+        return false;
+    }
+
+    stitchPath(forwardMeet, backwardMeet);
+    return true;
+}
+
+int BidirectionalPlanner::getSearchMapState(glm::ivec2 coord) const
+{
+    auto state = PathPlanner::getSearchMapState(coord);
+    if (state != cSearchMapUnvisited
+        || static_cast<int>(_reverseStamps.size()) != _resolution * _resolution)
+    {
+        return state;
+    }
+
+    return getDistance(false, getIndex(coord));
+}
+
+int BidirectionalPlanner::getDistance(bool forward, int index) const
+{
+    if (forward)
+    {
+        return _searchMapStamps[index] == _searchGeneration
+            ? _searchMap[index]
+            : cSearchMapUnvisited;
+    }
+
+    return _reverseStamps[index] == _searchGeneration
+        ? _reverseSearchMap[index]
+        : cSearchMapUnvisited;
+}
+
+void BidirectionalPlanner::visit(
+    bool forward,
+    int index,
+    int distance,
+    glm::ivec2 parent
+)
+{
+    if (forward)
+    {
+        _searchMap[index] = distance;
+        _searchMapStamps[index] = _searchGeneration;
+        setTraceback(index, parent);
+        return;
+    }
+
+    _reverseSearchMap[index] = distance;
+    _reverseSearchMapTraceback[index] = parent;
+    _reverseStamps[index] = _searchGeneration;
+}
+
+glm::ivec2 BidirectionalPlanner::getReverseTraceback(int index) const
+{
+    return _reverseStamps[index] == _searchGeneration
+        ? _reverseSearchMapTraceback[index]
+        : glm::ivec2{-1, -1};
+}
+
+void BidirectionalPlanner::stitchPath(
+    glm::ivec2 forwardMeet,
+    glm::ivec2 backwardMeet
+)
+{
+    std::vector<glm::ivec2> forwardPath;
+    for (auto current = forwardMeet;
+        current != glm::ivec2{-1, -1};
+        current = getTraceback(getIndex(current)))
+    {
+        forwardPath.push_back(current);
+    }
+
+    _path.clear();
+    std::reverse_copy(
+        std::begin(forwardPath),
+        std::end(forwardPath),
+        std::back_inserter(_path)
+    );
+
+    for (auto current = backwardMeet;
+        current != glm::ivec2{-1, -1};
+        current = getReverseTraceback(getIndex(current)))
+    {
+        _path.push_back(current);
+    }
+}
+
+}
@@ -0,0 +1,119 @@
+#include "BreadthFirstPlanner.hpp"
+
+#include <algorithm>
+
+namespace kinematic
+{
+
+BreadthFirstPlanner::BreadthFirstPlanner()
+{
+}
+
+BreadthFirstPlanner::~BreadthFirstPlanner()
+{
+}
+
+bool BreadthFirstPlanner::findPath(
+    const ConfigurationSpace& space,
+    glm::ivec2 start,
+    glm::ivec2 end
+)
+{
+    resetSearch(space.getResolution());
+    _workspace.reset(_resolution * _resolution);
+    resetSearchMap();
+
+    const int dirx[] = {-1, 0, +1, 0};
+    const int diry[] = {0, -1, 0, +1};
+
+    std::uint32_t startCell = getIndex(start);
+    std::uint32_t endCell = getIndex(end);
+
+    _workspace.visit(startCell, 0);
+    _workspace.pushFrontier(startCell);
+
+    if (_searchMapRecording)
+    {
+        markSearchMap(start, 0);
+    }
+
+    bool found = false;
+    int distance = 0;
+    auto levelRemaining = _workspace.getFrontierSize();
+
+    while (!_workspace.isFrontierEmpty())
+    {
+        if (levelRemaining == 0)
+        {
+            ++distance;
+            levelRemaining = _workspace.getFrontierSize();
+        }
+
+        auto cell = _workspace.popFrontier();
+        --levelRemaining;
+
+        if (cell == endCell)
+        {
+            found = true;
+            break;
+        }
+
+        ++_expandedNodes;
+        _maxDistance = std::max(_maxDistance, distance + 1);
+
+        glm::ivec2 current{
+            static_cast<int>(cell) / _resolution,
+            static_cast<int>(cell) % _resolution
+        };
+
+        for (auto i = 0; i < 4; ++i)
+        {
+            auto next = wrap({current.x + dirx[i], current.y + diry[i]});
+            std::uint32_t nextCell = getIndex(next);
+
+            if (_workspace.isVisited(nextCell)) { continue; }
+            if (!space.verifyAvailability(next)) { continue; }
+
+            _workspace.visit(nextCell, i);
+            _workspace.pushFrontier(nextCell);
+
+            if (_searchMapRecording)
+            {
+                markSearchMap(next, distance + 1);
+            }
+        }
+    }
+
+    if (found)
+    {
+        trackbackDirections(start, end);
+    }
+
+    return found;
+}
+
+void BreadthFirstPlanner::trackbackDirections(
+    glm::ivec2 start,
+    glm::ivec2 end
+)
+{
+    const int dirx[] = {-1, 0, +1, 0};
+    const int diry[] = {0, -1, 0, +1};
+
+    auto current = end;
+    _path.push_back(current);
+
+    while (current != start)
+    {
+        auto direction = _workspace.getDirection(getIndex(current));
+        current = wrap({
+            current.x - dirx[direction],
+            current.y - diry[direction]
+        });
+        _path.push_back(current);
+    }
+
+    std::reverse(std::begin(_path), std::end(_path));
+}
+
+}
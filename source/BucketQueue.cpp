@@ -0,0 +1,72 @@
+#include "BucketQueue.hpp"
+
+namespace kinematic
+{
+
+BucketQueue::BucketQueue():
+    _span{0},
+    _currentKey{0},
+    _size{0}
+{
+}
+
+BucketQueue::~BucketQueue()
+{
+}
+
+void BucketQueue::reset(int span)
+{
+    if (span > static_cast<int>(_buckets.size()))
+    {
+        _buckets.resize(span);
+    }
+
+    for (auto& bucket: _buckets)
+    {
+        bucket.clear();
+    }
+
+    _span = span;
+    _currentKey = 0;
+    _size = 0;
+}
+
+bool BucketQueue::isEmpty() const
+{
+    return _size == 0;
+}
+
+void BucketQueue::push(std::uint32_t value, int key)
+{
+    // Scanning starts from the smallest key, and the first push after the
+    // queue ran dry may carry a larger key than the ones that follow it.
+    if (_size == 0 || key < _currentKey)
+    {
+        _currentKey = key;
+    }
+
+    _buckets[key % _span].push_back(value);
+    ++_size;
+}
+
+std::uint32_t BucketQueue::pop()
+{
+    while (_buckets[_currentKey % _span].empty())
+    {
+        ++_currentKey;
+    }
+
+    auto& bucket = _buckets[_currentKey % _span];
+    auto value = bucket.back();
+    bucket.pop_back();
+    --_size;
+
+    return value;
+}
+
+int BucketQueue::getCurrentKey() const
+{
+    return _currentKey;
+}
+
+}
@@ -0,0 +1,218 @@
+#include "ChainConfigurationSpace.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "glm/gtc/constants.hpp"
+
+namespace kinematic
+{
+
+ChainConfigurationSpace::ChainConfigurationSpace():
+    _revision{ConfigurationSpace::createRevision()}
+{
+}
+
+ChainConfigurationSpace::~ChainConfigurationSpace()
+{
+}
+
+void ChainConfigurationSpace::setChain(const KinematicChain& chain)
+{
+    // Snapshots set the same chain before every query; that must not look
+    // like a change to planners caching collision results.
+    if (chain.getLinkLengths() == _chain.getLinkLengths())
+    {
+        return;
+    }
+
+    _chain = chain;
+    _revision = ConfigurationSpace::createRevision();
+}
+
+const KinematicChain& ChainConfigurationSpace::getChain() const
+{
+    return _chain;
+}
+
+int ChainConfigurationSpace::getDimension() const
+{
+    return _chain.getJointCount();
+}
+
+void ChainConfigurationSpace::setObstacles(
+    std::shared_ptr<const ConfigurationSpace> obstacles
+)
+{
+    if (obstacles == _obstacles)
+    {
+        return;
+    }
+
+    _obstacles = obstacles;
+    _revision = ConfigurationSpace::createRevision();
+}
+
+unsigned long ChainConfigurationSpace::getRevision() const
+{
+    // Both numbers come from the same increasing counter, so the larger
+    // one changes with either side.
+    if (!_obstacles)
+    {
+        return _revision;
+    }
+
+    return std::max(_revision, _obstacles->getRevision());
+}
+
+bool ChainConfigurationSpace::checkConfiguration(const float* angles) const
+{
+    return checkLinks(angles, 0.0f);
+}
+
+bool ChainConfigurationSpace::checkConfiguration(
+    const JointVector& angles
+) const
+{
+    return checkLinks(angles.data(), 0.0f);
+}
+
+bool ChainConfigurationSpace::checkLinks(
+    const float* angles,
+    float margin
+) const
+{
+    if (_obstacles == nullptr)
+    {
+        return true;
+    }
+
+    const auto& linkLengths = _chain.getLinkLengths();
+    glm::vec2 position{0.0f, 0.0f};
+    float heading = 0.0f;
+
+    for (auto joint = 0; joint < getDimension(); ++joint)
+    {
+        heading += angles[joint];
+        auto next = position + linkLengths[joint]
+            * glm::vec2{std::cos(heading), std::sin(heading)};
+
+        if (_obstacles->checkArmConstraintCollision(position, next, margin))
+        {
+            return false;
+        }
+
+        position = next;
+    }
+
+    return true;
+}
+
+bool ChainConfigurationSpace::checkMotion(
+    const float* from,
+    const float* to,
+    float maxTravel
+) const
+{
+    if (isMapBacked())
+    {
+        return checkMapMotion(from, to);
+    }
+
+    auto dimension = getDimension();
+    JointVector delta(dimension), current(dimension);
+
+    // Turning a joint moves points of the chain by at most the angle times
+    // the length of the links past it, so summing that over the joints
+    // bounds how far anything travels during the move.
+    const auto& linkLengths = _chain.getLinkLengths();
+    float leverArm = 0.0f, travel = 0.0f;
+    for (auto joint = dimension - 1; joint >= 0; --joint)
+    {
+        delta[joint] = getAngleDifference(from[joint], to[joint]);
+        leverArm += linkLengths[joint];
+        travel += std::abs(delta[joint]) * leverArm;
+    }
+
+    auto steps = std::max(1, static_cast<int>(std::ceil(travel / maxTravel)));
+    auto margin = 0.5f * maxTravel;
+    for (auto step = 0; step <= steps; ++step)
+    {
+        auto t = static_cast<float>(step) / steps;
+        for (auto joint = 0; joint < dimension; ++joint)
+        {
+            current[joint] = from[joint] + t * delta[joint];
+        }
+
+        if (!checkLinks(current.data(), margin))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ChainConfigurationSpace::isMapBacked() const
+{
+    if (_obstacles == nullptr
+        || getDimension() != 2
+        || !_obstacles->isAvailabilityMapCreated())
+    {
+        return false;
+    }
+
+    const auto& linkLengths = _chain.getLinkLengths();
+    return linkLengths[0] == _obstacles->getFirstArmLength()
+        && linkLengths[1] == _obstacles->getSecondArmLength();
+}
+
+bool ChainConfigurationSpace::checkMapMotion(
+    const float* from,
+    const float* to
+) const
+{
+    auto scale = _obstacles->getResolution() / glm::two_pi<float>();
+    return _obstacles->checkCellLine(
+        {from[0] * scale, from[1] * scale},
+        {
+            getAngleDifference(from[0], to[0]) * scale,
+            getAngleDifference(from[1], to[1]) * scale
+        }
+    );
+}
+
+float ChainConfigurationSpace::getDistance(
+    const JointVector& from,
+    const JointVector& to
+) const
+{
+    float distance = 0.0f;
+    for (auto joint = 0; joint < getDimension(); ++joint)
+    {
+        distance += std::abs(getAngleDifference(from[joint], to[joint]));
+    }
+
+    return distance;
+}
+
+float ChainConfigurationSpace::wrapAngle(float angle)
+{
+    auto wrapped = std::fmod(angle, glm::two_pi<float>());
+    if (wrapped < 0.0f) { wrapped += glm::two_pi<float>(); }
+    if (wrapped >= glm::two_pi<float>()) { wrapped = 0.0f; }
+    return wrapped;
+}
+
+float ChainConfigurationSpace::getAngleDifference(float from, float to)
+{
+    auto difference = wrapAngle(to - from);
+    if (difference > glm::pi<float>())
+    {
+        difference -= glm::two_pi<float>();
+    }
+
+    return difference;
+}
+
+}
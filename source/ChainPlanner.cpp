@@ -0,0 +1,31 @@
+#include "ChainPlanner.hpp"
+
+namespace kinematic
+{
+
+ChainPlanner::ChainPlanner():
+    _expandedNodes{0}
+{
+}
+
+ChainPlanner::~ChainPlanner()
+{
+}
+
+const std::vector<JointVector>& ChainPlanner::getPath() const
+{
+    return _path;
+}
+
+int ChainPlanner::getExpandedNodes() const
+{
+    return _expandedNodes;
+}
+
+void ChainPlanner::resetSearch()
+{
+    _expandedNodes = 0;
+    _path.clear();
+}
+
+}
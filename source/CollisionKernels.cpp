@@ -0,0 +1,259 @@
+#include "CollisionKernels.hpp"
+
+#include <algorithm>
+
+#include "SimdLanes.hpp"
+
+namespace kinematic
+{
+
+using namespace simd;
+
+const int AABBBatch::cLaneCount = cLanes;
+
+AABBBatch::AABBBatch():
+    _count{0}
+{
+}
+
+AABBBatch::~AABBBatch()
+{
+}
+
+void AABBBatch::assign(const std::vector<fw::AABB<glm::vec2>>& boxes)
+{
+    _count = static_cast<int>(boxes.size());
+
+    _centerX.resize(_count);
+    _centerY.resize(_count);
+    _extentX.resize(_count);
+    _extentY.resize(_count);
+
+    for (auto i = 0; i < _count; ++i)
+    {
+        set(i, boxes[i]);
+    }
+}
+
+void AABBBatch::set(int index, const fw::AABB<glm::vec2>& box)
+{
+    _centerX[index] = 0.5f * (box.min.x + box.max.x);
+    _centerY[index] = 0.5f * (box.min.y + box.max.y);
+    _extentX[index] = 0.5f * (box.max.x - box.min.x);
+    _extentY[index] = 0.5f * (box.max.y - box.min.y);
+}
+
+int AABBBatch::size() const
+{
+    return _count;
+}
+
+bool AABBBatch::intersectsSegment(
+    const glm::vec2& start,
+    const glm::vec2& end,
+    float margin
+) const
+{
+    auto halfX = 0.5f * (end.x - start.x);
+    auto halfY = 0.5f * (end.y - start.y);
+    auto midX = 0.5f * (start.x + end.x);
+    auto midY = 0.5f * (start.y + end.y);
+    auto absHalfX = std::fabs(halfX);
+    auto absHalfY = std::fabs(halfY);
+
+    auto i = 0;
+
+#if defined(KINEMATIC_SIMD)
+    auto hx = broadcast(halfX);
+    auto hy = broadcast(halfY);
+    auto ahx = broadcast(absHalfX);
+    auto ahy = broadcast(absHalfY);
+    auto mx = broadcast(midX);
+    auto my = broadcast(midY);
+    auto grow = broadcast(margin);
+
+    // Full vectors only; the boxes left over go through the scalar loop.
+    for (; i + cLanes <= _count; i += cLanes)
+    {
+        auto ex = add(load(&_extentX[i]), grow);
+        auto ey = add(load(&_extentY[i]), grow);
+        auto dx = sub(mx, load(&_centerX[i]));
+        auto dy = sub(my, load(&_centerY[i]));
+
+        auto overlapX = lessEqual(absolute(dx), add(ex, ahx));
+        auto overlapY = lessEqual(absolute(dy), add(ey, ahy));
+        auto overlapAxis = lessEqual(
+            absolute(sub(mul(hx, dy), mul(hy, dx))),
+            add(mul(ex, ahy), mul(ey, ahx))
+        );
+
+        if (mask(both(overlapX, both(overlapY, overlapAxis))) != 0)
+        {
+            return true;
+        }
+    }
+#endif
+
+    for (; i < _count; ++i)
+    {
+        auto dx = midX - _centerX[i];
+        auto dy = midY - _centerY[i];
+        auto ex = _extentX[i] + margin;
+        auto ey = _extentY[i] + margin;
+
+        if (std::fabs(dx) <= ex + absHalfX
+            && std::fabs(dy) <= ey + absHalfY
+            && std::fabs(halfX * dy - halfY * dx)
+                <= ex * absHalfY + ey * absHalfX)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void collideSegmentsWithAABB(
+    const float* startX,
+    const float* startY,
+    const float* endX,
+    const float* endY,
+    int count,
+    const fw::AABB<glm::vec2>& aabb,
+    unsigned char* hits
+)
+{
+    auto i = 0;
+
+#if defined(KINEMATIC_SIMD)
+    auto half = broadcast(0.5f);
+    auto cx = broadcast(0.5f * (aabb.min.x + aabb.max.x));
+    auto cy = broadcast(0.5f * (aabb.min.y + aabb.max.y));
+    auto ex = broadcast(0.5f * (aabb.max.x - aabb.min.x));
+    auto ey = broadcast(0.5f * (aabb.max.y - aabb.min.y));
+
+    for (; i + cLanes <= count; i += cLanes)
+    {
+        auto sx = load(startX + i);
+        auto sy = load(startY + i);
+        auto fx = load(endX + i);
+        auto fy = load(endY + i);
+
+        auto hx = mul(half, sub(fx, sx));
+        auto hy = mul(half, sub(fy, sy));
+        auto ahx = absolute(hx);
+        auto ahy = absolute(hy);
+        auto dx = sub(mul(half, add(sx, fx)), cx);
+        auto dy = sub(mul(half, add(sy, fy)), cy);
+
+        auto overlapX = lessEqual(absolute(dx), add(ex, ahx));
+        auto overlapY = lessEqual(absolute(dy), add(ey, ahy));
+        auto overlapAxis = lessEqual(
+            absolute(sub(mul(hx, dy), mul(hy, dx))),
+            add(mul(ex, ahy), mul(ey, ahx))
+        );
+
+        auto bits = mask(both(overlapX, both(overlapY, overlapAxis)));
+        for (auto lane = 0; bits != 0; ++lane, bits >>= 1)
+        {
+            hits[i + lane] |= static_cast<unsigned char>(bits & 1);
+        }
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        if (intersectSegmentAABB(
+            {startX[i], startY[i]},
+            {endX[i], endY[i]},
+            aabb))
+        {
+            hits[i] = 1;
+        }
+    }
+}
+
+bool getAABBSectorInDisk(
+    const glm::vec2& centre,
+    float radius,
+    const fw::AABB<glm::vec2>& aabb,
+    float& lowAngle,
+    float& highAngle
+)
+{
+    const float cPi = 3.14159265358979323846f;
+
+    auto low = aabb.min - centre;
+    auto high = aabb.max - centre;
+
+    if (low.x <= 0.0f && high.x >= 0.0f && low.y <= 0.0f && high.y >= 0.0f)
+    {
+        lowAngle = -cPi;
+        highAngle = cPi;
+        return true;
+    }
+
+    glm::vec2 closest{
+        std::min(std::max(0.0f, low.x), high.x),
+        std::min(std::max(0.0f, low.y), high.y)
+    };
+
+    if (glm::length(closest) > radius)
+    {
+        return false;
+    }
+
+    // The clipped box is convex and misses the centre, so it spans less
+    // than half a turn around the direction of its closest point.
+    auto reference = std::atan2(closest.y, closest.x);
+    lowAngle = highAngle = 0.0f;
+
+    auto include = [&](float x, float y)
+    {
+        auto offset = std::atan2(y, x) - reference;
+        if (offset > cPi) { offset -= 2.0f * cPi; }
+        if (offset < -cPi) { offset += 2.0f * cPi; }
+        lowAngle = std::min(lowAngle, offset);
+        highAngle = std::max(highAngle, offset);
+    };
+
+    auto radiusSquared = radius * radius;
+    const float xs[] = {low.x, high.x};
+    const float ys[] = {low.y, high.y};
+
+    for (auto x: xs)
+    {
+        for (auto y: ys)
+        {
+            if (x * x + y * y <= radiusSquared) { include(x, y); }
+        }
+
+        // Where the circle crosses this vertical edge.
+        auto remainder = radiusSquared - x * x;
+        if (remainder < 0.0f) { continue; }
+        auto crossing = std::sqrt(remainder);
+        if (crossing >= low.y && crossing <= high.y) { include(x, crossing); }
+        if (-crossing >= low.y && -crossing <= high.y)
+        {
+            include(x, -crossing);
+        }
+    }
+
+    for (auto y: ys)
+    {
+        auto remainder = radiusSquared - y * y;
+        if (remainder < 0.0f) { continue; }
+        auto crossing = std::sqrt(remainder);
+        if (crossing >= low.x && crossing <= high.x) { include(crossing, y); }
+        if (-crossing >= low.x && -crossing <= high.x)
+        {
+            include(-crossing, y);
+        }
+    }
+
+    lowAngle += reference;
+    highAngle += reference;
+    return true;
+}
+
+}
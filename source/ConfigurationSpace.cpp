@@ -0,0 +1,718 @@
+#include "ConfigurationSpace.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <atomic>
+#include <cstdint>
+
+#include "glm/gtc/constants.hpp"
+
+namespace kinematic
+{
+
+namespace
+{
+    const int cDefaultResolution = 360;
+    const int cRowsPerTask = 4;
+
+    // Spaces copied for background work keep their revision, so numbers
+    // are drawn from one counter: equal revisions mean the same space.
+    std::atomic<unsigned long> gLastRevision{0};
+
+    // Below this many constraints a SIMD scan beats walking the index.
+    const int cIndexedQueryThreshold = 64;
+
+    // Tolerance, in steps, added around analytic angle ranges so float
+    // rounding errs on the blocked side.
+    const float cStepTolerance = 1e-3f;
+
+    // Cyclic run of steps, `count` long starting at `first`.
+    struct StepInterval
+    {
+        int first, count;
+
+        bool contains(int step, int resolution) const
+        {
+            auto offset = (step - first) % resolution;
+            if (offset < 0) { offset += resolution; }
+            return offset < count;
+        }
+    };
+
+    // What a constraint does to the grid: rows in `firstLinkSteps` are
+    // blocked whole, rows in `secondLinkSteps` need their beta spans
+    // computed against `reach`.
+    struct ConstraintSweep
+    {
+        fw::AABB<glm::vec2> reach;
+        int delta;
+        StepInterval firstLinkSteps;
+        StepInterval secondLinkSteps;
+    };
+
+    // A cell stands for every angle within half a step of its own, so this
+    // returns the cells overlapping [lowAngle, highAngle].
+    StepInterval getStepInterval(
+        float lowAngle,
+        float highAngle,
+        int resolution
+    )
+    {
+        if (highAngle < lowAngle) { return {0, 0}; }
+
+        auto cellAngle = glm::two_pi<float>() / resolution;
+        auto first = static_cast<int>(std::ceil(
+            lowAngle / cellAngle - 0.5f - cStepTolerance
+        ));
+        auto last = static_cast<int>(std::floor(
+            highAngle / cellAngle + 0.5f + cStepTolerance
+        ));
+        auto count = std::min(last - first + 1, resolution);
+
+        first %= resolution;
+        if (first < 0) { first += resolution; }
+
+        return {first, count};
+    }
+
+    ConstraintSweep sweepConstraint(
+        const fw::AABB<glm::vec2>& constraint,
+        int delta,
+        float firstArmLength,
+        float secondArmLength,
+        int resolution
+    )
+    {
+        // Within one alpha cell the elbow strays at most this far from
+        // where it is at the cell centre, so testing the second link from
+        // there against a box grown by it covers the whole cell.
+        auto growth = 0.5f * firstArmLength * glm::two_pi<float>()
+            / resolution;
+        fw::AABB<glm::vec2> reach{
+            constraint.min - glm::vec2{growth, growth},
+            constraint.max + glm::vec2{growth, growth}
+        };
+
+        ConstraintSweep sweep{reach, delta, {0, 0}, {0, 0}};
+
+        float lowAngle, highAngle;
+        if (getAABBSectorInDisk(
+            {0.0f, 0.0f},
+            firstArmLength,
+            constraint,
+            lowAngle,
+            highAngle))
+        {
+            sweep.firstLinkSteps = getStepInterval(
+                lowAngle,
+                highAngle,
+                resolution
+            );
+        }
+
+        glm::vec2 closest{
+            std::min(std::max(0.0f, reach.min.x), reach.max.x),
+            std::min(std::max(0.0f, reach.min.y), reach.max.y)
+        };
+        glm::vec2 farthest{
+            std::max(std::abs(reach.min.x), std::abs(reach.max.x)),
+            std::max(std::abs(reach.min.y), std::abs(reach.max.y))
+        };
+        auto nearDistance = glm::length(closest);
+        auto farDistance = glm::length(farthest);
+
+        if (nearDistance > firstArmLength + secondArmLength)
+        {
+            return sweep;
+        }
+
+        if (nearDistance == 0.0f)
+        {
+            sweep.secondLinkSteps = {0, resolution};
+            return sweep;
+        }
+
+        getAABBSectorInDisk(
+            {0.0f, 0.0f},
+            farDistance,
+            reach,
+            lowAngle,
+            highAngle
+        );
+
+        // The second link reaches a point at distance d from the base only
+        // if the elbow is within acos((l1^2 + d^2 - l2^2) / (2 l1 d)) of
+        // its direction. That bound is loosest at d = sqrt(l1^2 - l2^2).
+        auto lengthDifference = firstArmLength * firstArmLength
+            - secondArmLength * secondArmLength;
+        auto distance = std::sqrt(std::max(lengthDifference, 0.0f));
+        distance = std::min(std::max(distance, nearDistance), farDistance);
+
+        auto cosine = (lengthDifference + distance * distance)
+            / (2.0f * firstArmLength * distance);
+
+        if (cosine <= -1.0f)
+        {
+            sweep.secondLinkSteps = {0, resolution};
+        }
+        else if (cosine <= 1.0f)
+        {
+            auto spread = std::acos(cosine);
+            sweep.secondLinkSteps = getStepInterval(
+                lowAngle - spread,
+                highAngle + spread,
+                resolution
+            );
+        }
+
+        return sweep;
+    }
+}
+
+ConfigurationSpace::ConfigurationSpace():
+    _threadPool{ThreadPool::getShared()},
+    _firstArmLength{0.3f},
+    _secondArmLength{0.3f},
+    _resolution{cDefaultResolution},
+    _availabilityMapCreated{false},
+    _revision{0}
+{
+}
+
+ConfigurationSpace::~ConfigurationSpace()
+{
+}
+
+void ConfigurationSpace::setThreadPool(std::shared_ptr<ThreadPool> threadPool)
+{
+    _threadPool = threadPool;
+}
+
+std::shared_ptr<ThreadPool> ConfigurationSpace::getThreadPool() const
+{
+    return _threadPool;
+}
+
+void ConfigurationSpace::setArmLengths(
+    float firstArmLength,
+    float secondArmLength
+)
+{
+    if (_firstArmLength == firstArmLength
+        && _secondArmLength == secondArmLength)
+    {
+        return;
+    }
+
+    _firstArmLength = firstArmLength;
+    _secondArmLength = secondArmLength;
+
+    // Footprints of every constraint depend on the arm, so the counts
+    // cannot be patched and the map has to be calculated again.
+    _availabilityMapCreated = false;
+    _revision = createRevision();
+}
+
+float ConfigurationSpace::getFirstArmLength() const
+{
+    return _firstArmLength;
+}
+
+float ConfigurationSpace::getSecondArmLength() const
+{
+    return _secondArmLength;
+}
+
+void ConfigurationSpace::setConstraints(
+    const std::vector<fw::AABB<glm::vec2>>& constraints
+)
+{
+    _constraints = constraints;
+    _constraintBatch.assign(_constraints);
+    _constraintIndex.assign(_constraints);
+
+    if (_availabilityMapCreated)
+    {
+        createAvailabilityMap();
+    }
+
+    _revision = createRevision();
+}
+
+int ConfigurationSpace::addConstraint(const fw::AABB<glm::vec2>& constraint)
+{
+    _constraints.push_back(constraint);
+    _constraintBatch.assign(_constraints);
+    _constraintIndex.add(constraint);
+
+    if (_availabilityMapCreated)
+    {
+        updateConstraintFootprints({}, {constraint}, nullptr);
+    }
+
+    _revision = createRevision();
+    return static_cast<int>(_constraints.size()) - 1;
+}
+
+void ConfigurationSpace::setConstraint(
+    int index,
+    const fw::AABB<glm::vec2>& constraint
+)
+{
+    auto previous = _constraints[index];
+    if (previous.min == constraint.min && previous.max == constraint.max)
+    {
+        return;
+    }
+
+    _constraints[index] = constraint;
+    _constraintBatch.set(index, constraint);
+    _constraintIndex.set(index, constraint);
+
+    if (_availabilityMapCreated)
+    {
+        updateConstraintFootprints({previous}, {constraint}, nullptr);
+    }
+
+    _revision = createRevision();
+}
+
+void ConfigurationSpace::removeConstraint(int index)
+{
+    auto removed = _constraints[index];
+
+    std::swap(_constraints.back(), _constraints[index]);
+    _constraints.pop_back();
+    _constraintBatch.assign(_constraints);
+    _constraintIndex.remove(index);
+
+    if (_availabilityMapCreated)
+    {
+        updateConstraintFootprints({removed}, {}, nullptr);
+    }
+
+    _revision = createRevision();
+}
+
+const std::vector<fw::AABB<glm::vec2>>&
+    ConfigurationSpace::getConstraints() const
+{
+    return _constraints;
+}
+
+int ConfigurationSpace::findConstraint(glm::vec2 point) const
+{
+    return _constraintIndex.findContaining(point);
+}
+
+std::pair<glm::vec2, glm::vec2> ConfigurationSpace::buildConfiguration(
+    float alpha,
+    float beta
+) const
+{
+    glm::vec2 p0{0.0f, 0.0f};
+
+    glm::vec2 p1 = p0 + glm::vec2{
+        _firstArmLength * cosf(alpha),
+        _firstArmLength * sinf(alpha)
+    };
+
+    glm::vec2 p2 = p1 + glm::vec2{
+        _secondArmLength * cosf(alpha + beta),
+        _secondArmLength * sinf(alpha + beta)
+    };
+
+    return {p1, p2};
+}
+
+bool ConfigurationSpace::checkConfiguration(float alpha, float beta) const
+{
+    auto config = buildConfiguration(alpha, beta);
+    return !(checkArmConstraintCollision({0, 0}, config.first)
+        || checkArmConstraintCollision(config.first, config.second));
+}
+
+bool ConfigurationSpace::checkArmConstraintCollision(
+    glm::vec2 start,
+    glm::vec2 end,
+    float margin
+) const
+{
+    if (_constraintIndex.size() < cIndexedQueryThreshold)
+    {
+        return _constraintBatch.intersectsSegment(start, end, margin);
+    }
+
+    return _constraintIndex.intersectsSegment(start, end, margin);
+}
+
+bool ConfigurationSpace::checkSegmentAABBCollision(
+    const glm::vec2& start,
+    const glm::vec2& end,
+    const fw::AABB<glm::vec2>& aabb
+) const
+{
+    return intersectSegmentAABB(start, end, aabb);
+}
+
+bool ConfigurationSpace::createAvailabilityMap(JobProgress* progress)
+{
+    _availabilityMapCreated = false;
+
+    auto cellCount = static_cast<size_t>(_resolution) * _resolution;
+    _obstacleCount.assign(cellCount, 0);
+    _occupancyGrid.resize(_resolution, _resolution);
+
+    if (_trigonometryTable.getResolution() != _resolution)
+    {
+        _trigonometryTable.create(_resolution);
+    }
+
+    if (!updateConstraintFootprints({}, _constraints, progress))
+    {
+        return false;
+    }
+
+    _availabilityMapCreated = true;
+    return true;
+}
+
+bool ConfigurationSpace::isAvailabilityMapCreated() const
+{
+    return _availabilityMapCreated;
+}
+
+const OccupancyGrid& ConfigurationSpace::getOccupancyGrid() const
+{
+    return _occupancyGrid;
+}
+
+unsigned long ConfigurationSpace::getRevision() const
+{
+    return _revision;
+}
+
+unsigned long ConfigurationSpace::createRevision()
+{
+    return ++gLastRevision;
+}
+
+void ConfigurationSpace::setResolution(int resolution)
+{
+    if (_resolution == resolution)
+    {
+        return;
+    }
+
+    _resolution = resolution;
+    _availabilityMapCreated = false;
+    _revision = createRevision();
+}
+
+int ConfigurationSpace::getResolution() const
+{
+    return _resolution;
+}
+
+float ConfigurationSpace::getCellAngle(int step) const
+{
+    return glm::radians(360.0f * step / _resolution);
+}
+
+glm::vec2 ConfigurationSpace::getCellAngles(glm::ivec2 coord) const
+{
+    return {getCellAngle(coord.x), getCellAngle(coord.y)};
+}
+
+glm::ivec2 ConfigurationSpace::getClosestInConfiguration(
+    glm::vec2 coord
+) const
+{
+    auto steps = glm::degrees(coord) * (_resolution / 360.0f);
+    glm::ivec2 clamped{
+        static_cast<int>(std::round(steps.x)) % _resolution,
+        static_cast<int>(std::round(steps.y)) % _resolution
+    };
+
+    if (clamped.x < 0) { clamped.x += _resolution; }
+    if (clamped.y < 0) { clamped.y += _resolution; }
+
+    return clamped;
+}
+
+bool ConfigurationSpace::verifyAvailability(glm::ivec2 coord) const
+{
+    return !_occupancyGrid.isOccupied(coord.x, coord.y);
+}
+
+bool ConfigurationSpace::checkCellLine(glm::vec2 from, glm::vec2 delta) const
+{
+    // Cells cover half a step around their angles, so in units shifted by
+    // half a cell the boundaries fall on integers. Every cell the segment
+    // touches is visited, both neighbours included when it passes through
+    // a corner.
+    auto position = from + 0.5f;
+
+    glm::ivec2 cell{
+        static_cast<int>(std::floor(position.x)),
+        static_cast<int>(std::floor(position.y))
+    };
+    glm::ivec2 last{
+        static_cast<int>(std::floor(position.x + delta.x)),
+        static_cast<int>(std::floor(position.y + delta.y))
+    };
+
+    auto isFree = [&](glm::ivec2 coord)
+    {
+        coord.x = (coord.x % _resolution + _resolution) % _resolution;
+        coord.y = (coord.y % _resolution + _resolution) % _resolution;
+        return verifyAvailability(coord);
+    };
+
+    glm::ivec2 step{delta.x < 0.0f ? -1 : 1, delta.y < 0.0f ? -1 : 1};
+    glm::vec2 length{std::abs(delta.x), std::abs(delta.y)};
+    glm::vec2 crossing{
+        length.x > 0.0f
+            ? (delta.x < 0.0f ? position.x - cell.x : cell.x + 1 - position.x)
+                / length.x
+            : 2.0f,
+        length.y > 0.0f
+            ? (delta.y < 0.0f ? position.y - cell.y : cell.y + 1 - position.y)
+                / length.y
+            : 2.0f
+    };
+    glm::vec2 advance{
+        length.x > 0.0f ? 1.0f / length.x : 2.0f,
+        length.y > 0.0f ? 1.0f / length.y : 2.0f
+    };
+
+    auto remaining = std::abs(last.x - cell.x) + std::abs(last.y - cell.y);
+    while (true)
+    {
+        if (!isFree(cell))
+        {
+            return false;
+        }
+
+        if (remaining <= 0)
+        {
+            return true;
+        }
+
+        if (crossing.x < crossing.y)
+        {
+            cell.x += step.x;
+            crossing.x += advance.x;
+            --remaining;
+        }
+        else if (crossing.y < crossing.x)
+        {
+            cell.y += step.y;
+            crossing.y += advance.y;
+            --remaining;
+        }
+        else
+        {
+            if (!isFree({cell.x + step.x, cell.y})
+                || !isFree({cell.x, cell.y + step.y}))
+            {
+                return false;
+            }
+
+            cell += step;
+            crossing += advance;
+            remaining -= 2;
+        }
+    }
+}
+
+bool ConfigurationSpace::updateConstraintFootprints(
+    const std::vector<fw::AABB<glm::vec2>>& removed,
+    const std::vector<fw::AABB<glm::vec2>>& added,
+    JobProgress* progress
+)
+{
+    std::vector<ConstraintSweep> sweeps;
+    sweeps.reserve(removed.size() + added.size());
+
+    for (const auto& constraint: removed)
+    {
+        sweeps.push_back(sweepConstraint(
+            constraint,
+            -1,
+            _firstArmLength,
+            _secondArmLength,
+            _resolution
+        ));
+    }
+
+    for (const auto& constraint: added)
+    {
+        sweeps.push_back(sweepConstraint(
+            constraint,
+            +1,
+            _firstArmLength,
+            _secondArmLength,
+            _resolution
+        ));
+    }
+
+    // Every alpha row is written by exactly one chunk, so the result does
+    // not depend on how the rows get scheduled. A cancelled update skips
+    // its remaining chunks and leaves the counts half written.
+    std::atomic<int> finishedRows{0};
+    _threadPool->parallelFor(
+        0,
+        _resolution,
+        cRowsPerTask,
+        [&](int firstAlphaStep, int lastAlphaStep)
+        {
+            if (progress != nullptr && progress->isCancelled())
+            {
+                return;
+            }
+
+            for (auto alphaStep = firstAlphaStep;
+                alphaStep < lastAlphaStep;
+                ++alphaStep)
+            {
+                bool touched = false;
+
+                for (const auto& sweep: sweeps)
+                {
+                    if (sweep.firstLinkSteps.contains(alphaStep, _resolution))
+                    {
+                        addObstacleSpan(alphaStep, 0, _resolution, sweep.delta);
+                        touched = true;
+                    }
+                    else if (sweep.secondLinkSteps.contains(
+                        alphaStep,
+                        _resolution))
+                    {
+                        touched |= rasterizeConstraintRow(
+                            sweep.reach,
+                            alphaStep,
+                            sweep.delta
+                        );
+                    }
+                }
+
+                if (touched)
+                {
+                    refreshAvailabilityRow(alphaStep);
+                }
+            }
+
+            if (progress != nullptr)
+            {
+                finishedRows += lastAlphaStep - firstAlphaStep;
+                progress->setProgress(
+                    static_cast<float>(finishedRows) / _resolution
+                );
+            }
+        }
+    );
+
+    if (progress != nullptr && progress->isCancelled())
+    {
+        return false;
+    }
+
+    _revision = createRevision();
+    return true;
+}
+
+bool ConfigurationSpace::rasterizeConstraintRow(
+    const fw::AABB<glm::vec2>& reach,
+    int alphaStep,
+    int delta
+)
+{
+    glm::vec2 elbow{
+        _firstArmLength * _trigonometryTable.getCos(alphaStep),
+        _firstArmLength * _trigonometryTable.getSin(alphaStep)
+    };
+
+    float lowAngle, highAngle;
+    if (!getAABBSectorInDisk(
+        elbow,
+        _secondArmLength,
+        reach,
+        lowAngle,
+        highAngle))
+    {
+        return false;
+    }
+
+    // Directions are absolute, beta is measured from alpha, which itself
+    // varies by half a step across the row's cells.
+    auto cellAngle = glm::two_pi<float>() / _resolution;
+    auto alpha = alphaStep * cellAngle;
+    auto betaSteps = getStepInterval(
+        lowAngle - alpha - 0.5f * cellAngle,
+        highAngle - alpha + 0.5f * cellAngle,
+        _resolution
+    );
+
+    if (betaSteps.count <= 0)
+    {
+        return false;
+    }
+
+    addObstacleSpan(alphaStep, betaSteps.first, betaSteps.count, delta);
+    return true;
+}
+
+void ConfigurationSpace::addObstacleSpan(
+    int alphaStep,
+    int firstBetaStep,
+    int count,
+    int delta
+)
+{
+    auto row = &_obstacleCount[static_cast<size_t>(_resolution) * alphaStep];
+    auto head = std::min(count, _resolution - firstBetaStep);
+    auto lastBetaStep = firstBetaStep + head;
+
+    for (auto betaStep = firstBetaStep; betaStep < lastBetaStep; ++betaStep)
+    {
+        row[betaStep] += delta;
+    }
+
+    for (auto betaStep = 0; betaStep < count - head; ++betaStep)
+    {
+        row[betaStep] += delta;
+    }
+}
+
+void ConfigurationSpace::refreshAvailabilityRow(int alphaStep)
+{
+    auto counts = &_obstacleCount[static_cast<size_t>(_resolution) * alphaStep];
+    auto words = _occupancyGrid.getRow(alphaStep);
+    for (auto betaStep = 0; betaStep < _resolution;)
+    {
+        std::uint64_t word = 0;
+        auto bits = std::min(
+            OccupancyGrid::cBitsPerWord,
+            _resolution - betaStep
+        );
+
+        for (auto bit = 0; bit < bits; ++bit)
+        {
+            word |= std::uint64_t{counts[betaStep + bit] != 0} << bit;
+        }
+
+        // A partial last word keeps its padding bits set.
+        auto wordIndex = betaStep / OccupancyGrid::cBitsPerWord;
+        if (bits < OccupancyGrid::cBitsPerWord)
+        {
+            word |= words[wordIndex] & ~((std::uint64_t{1} << bits) - 1);
+        }
+
+        words[wordIndex] = word;
+
+        betaStep += bits;
+    }
+}
+
+}
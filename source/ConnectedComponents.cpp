@@ -0,0 +1,182 @@
+#include "ConnectedComponents.hpp"
+
+#include <algorithm>
+
+namespace kinematic
+{
+
+const int ConnectedComponents::cOccupiedLabel = -1;
+
+ConnectedComponents::ConnectedComponents():
+    _columns{0},
+    _componentCount{0}
+{
+}
+
+ConnectedComponents::~ConnectedComponents()
+{
+}
+
+void ConnectedComponents::build(
+    const OccupancyGrid& grid,
+    ThreadPool& threadPool
+)
+{
+    const int rows = grid.getRows();
+    _columns = grid.getColumns();
+    _parent.resize(rows * _columns);
+    _labels.resize(rows * _columns);
+
+    const int chunkCount = std::min(
+        rows,
+        static_cast<int>(4 * threadPool.getThreadCount())
+    );
+
+    auto chunkBegin = [&](int chunk) { return chunk * rows / chunkCount; };
+
+    // Every chunk of rows only links cells it owns, so the chunks can be
+    // labelled independently and stitched together afterwards.
+    threadPool.parallelFor(
+        0,
+        chunkCount,
+        1,
+        [&](int firstChunk, int lastChunk)
+        {
+            for (auto chunk = firstChunk; chunk < lastChunk; ++chunk)
+            {
+                auto firstRow = chunkBegin(chunk);
+                auto lastRow = chunkBegin(chunk + 1);
+
+                for (auto row = firstRow; row < lastRow; ++row)
+                {
+                    for (auto column = 0; column < _columns; ++column)
+                    {
+                        auto cell = row * _columns + column;
+                        _parent[cell] = grid.isOccupied(row, column)
+                            ? cOccupiedLabel
+                            : cell;
+                    }
+
+                    for (auto column = 0; column < _columns; ++column)
+                    {
+                        auto cell = row * _columns + column;
+                        if (_parent[cell] == cOccupiedLabel) { continue; }
+
+                        auto left = column > 0 ? cell - 1 : cell + _columns - 1;
+                        if (_parent[left] != cOccupiedLabel)
+                        {
+                            unite(cell, left);
+                        }
+
+                        if (row > firstRow
+                            && _parent[cell - _columns] != cOccupiedLabel)
+                        {
+                            unite(cell, cell - _columns);
+                        }
+                    }
+                }
+            }
+        }
+    );
+
+    for (auto chunk = 0; chunk < chunkCount; ++chunk)
+    {
+        auto row = chunkBegin(chunk);
+        auto previousRow = row > 0 ? row - 1 : rows - 1;
+
+        for (auto column = 0; column < _columns; ++column)
+        {
+            auto cell = row * _columns + column;
+            auto above = previousRow * _columns + column;
+
+            if (_parent[cell] != cOccupiedLabel
+                && _parent[above] != cOccupiedLabel)
+            {
+                unite(cell, above);
+            }
+        }
+    }
+
+    threadPool.parallelFor(
+        0,
+        rows,
+        16,
+        [&](int firstRow, int lastRow)
+        {
+            for (auto cell = firstRow * _columns;
+                cell < lastRow * _columns;
+                ++cell)
+            {
+                _labels[cell] = _parent[cell] == cOccupiedLabel
+                    ? cOccupiedLabel
+                    : find(cell);
+            }
+        }
+    );
+
+    _componentCount = 0;
+    for (auto cell = 0; cell < rows * _columns; ++cell)
+    {
+        if (_labels[cell] == cell)
+        {
+            ++_componentCount;
+        }
+    }
+}
+
+int ConnectedComponents::getLabel(glm::ivec2 coord) const
+{
+    return _labels[coord.x * _columns + coord.y];
+}
+
+bool ConnectedComponents::areConnected(
+    glm::ivec2 first,
+    glm::ivec2 second
+) const
+{
+    auto label = getLabel(first);
+    return label != cOccupiedLabel && label == getLabel(second);
+}
+
+int ConnectedComponents::getComponentCount() const
+{
+    return _componentCount;
+}
+
+int ConnectedComponents::find(int cell) const
+{
+    while (_parent[cell] != cell)
+    {
+        cell = _parent[cell];
+    }
+
+    return cell;
+}
+
+int ConnectedComponents::findAndCompress(int cell)
+{
+    while (_parent[cell] != cell)
+    {
+        _parent[cell] = _parent[_parent[cell]];
+        cell = _parent[cell];
+    }
+
+    return cell;
+}
+
+void ConnectedComponents::unite(int first, int second)
+{
+    auto firstRoot = findAndCompress(first);
+    auto secondRoot = findAndCompress(second);
+
+    if (firstRoot < secondRoot)
+    {
+        _parent[secondRoot] = firstRoot;
+    }
+    else if (secondRoot < firstRoot)
+    {
+        _parent[firstRoot] = secondRoot;
+    }
+}
+
+}
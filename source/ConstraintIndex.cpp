@@ -0,0 +1,308 @@
+#include "ConstraintIndex.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+#include "CollisionKernels.hpp"
+
+namespace kinematic
+{
+
+namespace
+{
+    const int cMaxCellsPerBox = 256;
+
+    // Boxes are linked into cells grown by this fraction of a cell, so
+    // float error at cell borders cannot hide a touching box.
+    const float cBorderMargin = 1e-3f;
+
+    void eraseIndex(std::vector<int>& indices, int index)
+    {
+        auto it = std::find(std::begin(indices), std::end(indices), index);
+        if (it != std::end(indices))
+        {
+            *it = indices.back();
+            indices.pop_back();
+        }
+    }
+
+    fw::AABB<glm::vec2> grow(const fw::AABB<glm::vec2>& box, float margin)
+    {
+        return {box.min - glm::vec2{margin}, box.max + glm::vec2{margin}};
+    }
+}
+
+const float ConstraintIndex::cDefaultCellSize = 0.1f;
+
+ConstraintIndex::ConstraintIndex():
+    _cellSize{cDefaultCellSize}
+{
+}
+
+ConstraintIndex::~ConstraintIndex()
+{
+}
+
+void ConstraintIndex::setCellSize(float cellSize)
+{
+    if (cellSize == _cellSize)
+    {
+        return;
+    }
+
+    _cellSize = cellSize;
+    auto boxes = _boxes;
+    assign(boxes);
+}
+
+float ConstraintIndex::getCellSize() const
+{
+    return _cellSize;
+}
+
+void ConstraintIndex::assign(const std::vector<fw::AABB<glm::vec2>>& boxes)
+{
+    _boxes = boxes;
+    _cells.clear();
+    _oversized.clear();
+
+    for (auto i = 0; i < static_cast<int>(_boxes.size()); ++i)
+    {
+        link(i);
+    }
+}
+
+void ConstraintIndex::add(const fw::AABB<glm::vec2>& box)
+{
+    _boxes.push_back(box);
+    link(static_cast<int>(_boxes.size()) - 1);
+}
+
+void ConstraintIndex::set(int index, const fw::AABB<glm::vec2>& box)
+{
+    unlink(index);
+    _boxes[index] = box;
+    link(index);
+}
+
+void ConstraintIndex::remove(int index)
+{
+    auto last = static_cast<int>(_boxes.size()) - 1;
+
+    unlink(index);
+    if (index != last)
+    {
+        unlink(last);
+        _boxes[index] = _boxes[last];
+        link(index);
+    }
+
+    _boxes.pop_back();
+}
+
+int ConstraintIndex::size() const
+{
+    return static_cast<int>(_boxes.size());
+}
+
+bool ConstraintIndex::intersectsSegment(
+    const glm::vec2& start,
+    const glm::vec2& end,
+    float margin
+) const
+{
+    for (auto index: _oversized)
+    {
+        if (intersectSegmentAABB(start, end, grow(_boxes[index], margin)))
+        {
+            return true;
+        }
+    }
+
+    if (_cells.empty())
+    {
+        return false;
+    }
+
+    // Walks the cells crossed by the segment in order (Amanatides & Woo).
+    auto cell = getCell(start);
+    auto lastCell = getCell(end);
+    auto delta = end - start;
+
+    glm::ivec2 step{delta.x < 0.0f ? -1 : 1, delta.y < 0.0f ? -1 : 1};
+    glm::vec2 nextBoundary{
+        (cell.x + (step.x > 0 ? 1 : 0)) * _cellSize,
+        (cell.y + (step.y > 0 ? 1 : 0)) * _cellSize
+    };
+
+    const float cInfinity = std::numeric_limits<float>::infinity();
+    glm::vec2 tMax{
+        delta.x != 0.0f ? (nextBoundary.x - start.x) / delta.x : cInfinity,
+        delta.y != 0.0f ? (nextBoundary.y - start.y) / delta.y : cInfinity
+    };
+    glm::vec2 tDelta{
+        delta.x != 0.0f ? _cellSize / std::fabs(delta.x) : cInfinity,
+        delta.y != 0.0f ? _cellSize / std::fabs(delta.y) : cInfinity
+    };
+
+    auto remaining = std::abs(lastCell.x - cell.x)
+        + std::abs(lastCell.y - cell.y);
+
+    // Grown boxes may reach the segment from cells it does not cross, so
+    // the cells around each crossed one are searched as well.
+    auto reach = static_cast<int>(std::ceil(margin / _cellSize));
+
+    while (true)
+    {
+        for (auto x = cell.x - reach; x <= cell.x + reach; ++x)
+        {
+            for (auto y = cell.y - reach; y <= cell.y + reach; ++y)
+            {
+                if (intersectsCell({x, y}, start, end, margin))
+                {
+                    return true;
+                }
+            }
+        }
+
+        if (remaining-- == 0)
+        {
+            return false;
+        }
+
+        if (tMax.x < tMax.y)
+        {
+            cell.x += step.x;
+            tMax.x += tDelta.x;
+        }
+        else
+        {
+            cell.y += step.y;
+            tMax.y += tDelta.y;
+        }
+    }
+}
+
+int ConstraintIndex::findContaining(const glm::vec2& point) const
+{
+    int found = -1;
+
+    for (auto index: _oversized)
+    {
+        if (_boxes[index].contains(point) && (found < 0 || index < found))
+        {
+            found = index;
+        }
+    }
+
+    auto it = _cells.find(getKey(getCell(point)));
+    if (it != std::end(_cells))
+    {
+        for (auto index: it->second)
+        {
+            if (_boxes[index].contains(point) && (found < 0 || index < found))
+            {
+                found = index;
+            }
+        }
+    }
+
+    return found;
+}
+
+glm::ivec2 ConstraintIndex::getCell(const glm::vec2& point) const
+{
+    return {
+        static_cast<int>(std::floor(point.x / _cellSize)),
+        static_cast<int>(std::floor(point.y / _cellSize))
+    };
+}
+
+std::uint64_t ConstraintIndex::getKey(glm::ivec2 cell) const
+{
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cell.x))
+        << 32) | static_cast<std::uint32_t>(cell.y);
+}
+
+bool ConstraintIndex::isOversized(const fw::AABB<glm::vec2>& box) const
+{
+    auto extent = (box.max - box.min) / _cellSize;
+    return (extent.x + 2.0f) * (extent.y + 2.0f) > cMaxCellsPerBox;
+}
+
+void ConstraintIndex::link(int index)
+{
+    const auto& box = _boxes[index];
+    if (isOversized(box))
+    {
+        _oversized.push_back(index);
+        return;
+    }
+
+    auto margin = glm::vec2{cBorderMargin * _cellSize};
+    auto first = getCell(box.min - margin);
+    auto last = getCell(box.max + margin);
+
+    for (auto x = first.x; x <= last.x; ++x)
+    {
+        for (auto y = first.y; y <= last.y; ++y)
+        {
+            _cells[getKey({x, y})].push_back(index);
+        }
+    }
+}
+
+void ConstraintIndex::unlink(int index)
+{
+    const auto& box = _boxes[index];
+    if (isOversized(box))
+    {
+        eraseIndex(_oversized, index);
+        return;
+    }
+
+    auto margin = glm::vec2{cBorderMargin * _cellSize};
+    auto first = getCell(box.min - margin);
+    auto last = getCell(box.max + margin);
+
+    for (auto x = first.x; x <= last.x; ++x)
+    {
+        for (auto y = first.y; y <= last.y; ++y)
+        {
+            auto it = _cells.find(getKey({x, y}));
+            eraseIndex(it->second, index);
+            if (it->second.empty())
+            {
+                _cells.erase(it);
+            }
+        }
+    }
+}
+
+bool ConstraintIndex::intersectsCell(
+    glm::ivec2 cell,
+    const glm::vec2& start,
+    const glm::vec2& end,
+    float margin
+) const
+{
+    auto it = _cells.find(getKey(cell));
+    if (it == std::end(_cells))
+    {
+        return false;
+    }
+
+    for (auto index: it->second)
+    {
+        if (intersectSegmentAABB(start, end, grow(_boxes[index], margin)))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+}
@@ -0,0 +1,280 @@
+#include "CostMap.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace kinematic
+{
+
+const int CostMap::cCostScale = 16;
+const float CostMap::cDefaultJointWeight = 1.0f;
+const int CostMap::cDefaultClearanceRange = 8;
+const float CostMap::cDefaultClearancePenalty = 4.0f;
+
+CostMap::CostMap():
+    _jointWeights{cDefaultJointWeight, cDefaultJointWeight},
+    _clearanceRange{cDefaultClearanceRange},
+    _clearancePenalty{cDefaultClearancePenalty},
+    _space{nullptr},
+    _spaceRevision{0},
+    _valid{false},
+    _resolution{0},
+    _minStepCost{1, 1},
+    _maxStepCost{1}
+{
+}
+
+CostMap::~CostMap()
+{
+}
+
+void CostMap::setJointWeights(glm::vec2 jointWeights)
+{
+    _jointWeights = jointWeights;
+    _valid = false;
+}
+
+glm::vec2 CostMap::getJointWeights() const
+{
+    return _jointWeights;
+}
+
+void CostMap::setClearanceRange(int clearanceRange)
+{
+    _clearanceRange = clearanceRange;
+    _valid = false;
+}
+
+int CostMap::getClearanceRange() const
+{
+    return _clearanceRange;
+}
+
+void CostMap::setClearancePenalty(float clearancePenalty)
+{
+    _clearancePenalty = clearancePenalty;
+    _valid = false;
+}
+
+float CostMap::getClearancePenalty() const
+{
+    return _clearancePenalty;
+}
+
+void CostMap::create(const ConfigurationSpace& space)
+{
+    _space = &space;
+    _spaceRevision = space.getRevision();
+    _valid = true;
+    _resolution = space.getResolution();
+
+    computeClearance(space);
+
+    auto toCost = [](float cost)
+    {
+        return std::min(
+            static_cast<int>(std::numeric_limits<std::uint16_t>::max()),
+            std::max(1, static_cast<int>(std::round(cost)))
+        );
+    };
+
+    float baseCost[2];
+    for (auto axis = 0; axis < 2; ++axis)
+    {
+        baseCost[axis] = cCostScale * std::max(0.0f, _jointWeights[axis]);
+        _minStepCost[axis] = toCost(baseCost[axis]);
+        _stepCosts[axis].resize(_resolution * _resolution);
+    }
+
+    _maxStepCost = toCost(
+        std::max(baseCost[0], baseCost[1]) * (1.0f + _clearancePenalty)
+    );
+
+    auto range = static_cast<float>(std::max(1, _clearanceRange));
+    space.getThreadPool()->parallelFor(
+        0,
+        _resolution * _resolution,
+        4096,
+        [&](int firstCell, int lastCell)
+        {
+            for (auto cell = firstCell; cell < lastCell; ++cell)
+            {
+                auto factor = 1.0f + _clearancePenalty
+                    * std::max(0.0f, range - _clearance[cell]) / range;
+
+                for (auto axis = 0; axis < 2; ++axis)
+                {
+                    _stepCosts[axis][cell] = static_cast<std::uint16_t>(
+                        toCost(baseCost[axis] * factor)
+                    );
+                }
+            }
+        }
+    );
+}
+
+bool CostMap::isValid(const ConfigurationSpace& space) const
+{
+    return _valid
+        && _space == &space
+        && _spaceRevision == space.getRevision()
+        && space.isAvailabilityMapCreated();
+}
+
+void CostMap::invalidate()
+{
+    _valid = false;
+}
+
+float CostMap::getClearance(glm::ivec2 coord) const
+{
+    return _clearance[getIndex(coord)];
+}
+
+int CostMap::getStepCost(glm::ivec2 coord, int axis) const
+{
+    return _stepCosts[axis][getIndex(coord)];
+}
+
+int CostMap::getMinStepCost(int axis) const
+{
+    return _minStepCost[axis];
+}
+
+int CostMap::getMaxStepCost() const
+{
+    return _maxStepCost;
+}
+
+void CostMap::computeClearance(const ConfigurationSpace& space)
+{
+    // Felzenszwalb and Huttenlocher's separable transform. Rows first get
+    // the distance to the nearest obstacle along beta, then every column
+    // takes the lower envelope of parabolas over those squared distances.
+    // Both passes run over the line repeated so that it wraps.
+    auto n = _resolution;
+    auto threadPool = space.getThreadPool();
+    _clearance.resize(n * n);
+
+    // Farther than any two cells on the torus, squared.
+    const double cFar = static_cast<double>(n) * n;
+
+    threadPool->parallelFor(
+        0,
+        n,
+        16,
+        [&](int firstRow, int lastRow)
+        {
+            for (auto x = firstRow; x < lastRow; ++x)
+            {
+                auto* row = _clearance.data() + x * n;
+
+                auto obstacle = 0;
+                while (obstacle < n && space.verifyAvailability({x, obstacle}))
+                {
+                    ++obstacle;
+                }
+
+                if (obstacle == n)
+                {
+                    std::fill(row, row + n, static_cast<float>(cFar));
+                    continue;
+                }
+
+                row[obstacle] = 0.0f;
+                for (auto k = 1; k < n; ++k)
+                {
+                    auto y = (obstacle + k) % n;
+                    auto previous = (y + n - 1) % n;
+                    row[y] = space.verifyAvailability({x, y})
+                        ? row[previous] + 1.0f
+                        : 0.0f;
+                }
+
+                for (auto k = 1; k < n; ++k)
+                {
+                    auto y = (obstacle + n - k) % n;
+                    row[y] = std::min(row[y], row[(y + 1) % n] + 1.0f);
+                }
+
+                for (auto y = 0; y < n; ++y)
+                {
+                    row[y] *= row[y];
+                }
+            }
+        }
+    );
+
+    threadPool->parallelFor(
+        0,
+        n,
+        16,
+        [&](int firstColumn, int lastColumn)
+        {
+            auto length = 3 * n;
+            std::vector<double> values(length), bounds(length + 1);
+            std::vector<int> parabolas(length);
+
+            for (auto y = firstColumn; y < lastColumn; ++y)
+            {
+                for (auto q = 0; q < length; ++q)
+                {
+                    values[q] = _clearance[(q % n) * n + y];
+                }
+
+                auto intersect = [&](int q, int p)
+                {
+                    return (values[q] + static_cast<double>(q) * q
+                        - values[p] - static_cast<double>(p) * p)
+                        / (2.0 * (q - p));
+                };
+
+                auto k = 0;
+                parabolas[0] = 0;
+                bounds[0] = -std::numeric_limits<double>::infinity();
+                bounds[1] = std::numeric_limits<double>::infinity();
+
+                for (auto q = 1; q < length; ++q)
+                {
+                    auto s = intersect(q, parabolas[k]);
+                    while (s <= bounds[k])
+                    {
+                        --k;
+                        s = intersect(q, parabolas[k]);
+                    }
+
+                    ++k;
+                    parabolas[k] = q;
+                    bounds[k] = s;
+                    bounds[k + 1] = std::numeric_limits<double>::infinity();
+                }
+
+                k = 0;
+                for (auto q = n; q < 2 * n; ++q)
+                {
+                    while (bounds[k + 1] < q)
+                    {
+                        ++k;
+                    }
+
+                    auto offset = static_cast<double>(q - parabolas[k]);
+                    auto squared = std::min(
+                        cFar,
+                        offset * offset + values[parabolas[k]]
+                    );
+
+                    _clearance[(q - n) * n + y] =
+                        static_cast<float>(std::sqrt(squared));
+                }
+            }
+        }
+    );
+}
+
+int CostMap::getIndex(glm::ivec2 coord) const
+{
+    return _resolution * coord.x + coord.y;
+}
+
+}
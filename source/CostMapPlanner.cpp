@@ -0,0 +1,113 @@
+#include "CostMapPlanner.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace kinematic
+{
+
+CostMapPlanner::CostMapPlanner()
+{
+}
+
+CostMapPlanner::~CostMapPlanner()
+{
+}
+
+bool CostMapPlanner::findPath(
+    const ConfigurationSpace& space,
+    glm::ivec2 start,
+    glm::ivec2 end
+)
+{
+    resetSearch(space.getResolution());
+    resetSearchMap();
+    resetTraceback();
+
+    if (!_costMap.isValid(space))
+    {
+        _costMap.create(space);
+    }
+
+    // The heuristic never changes by more than one step cost per move, so
+    // keys grow by at most twice the largest step cost.
+    _openSet.reset(2 * _costMap.getMaxStepCost() + 1);
+    _openSet.push(getIndex(start), getHeuristic(start, end));
+    markSearchMap(start, 0);
+
+    const int dirx[] = {-1, 0, +1, 0};
+    const int diry[] = {0, -1, 0, +1};
+
+    bool found = false;
+    while (!_openSet.isEmpty())
+    {
+        auto index = static_cast<int>(_openSet.pop());
+        glm::ivec2 current{index / _resolution, index % _resolution};
+        auto distance = getSearchMapValue(current);
+
+        // Entries whose cost was improved after they got queued are left
+        // in their old bucket and skipped here.
+        if (distance + getHeuristic(current, end)
+            != _openSet.getCurrentKey())
+        {
+            continue;
+        }
+
+        if (current == end)
+        {
+            found = true;
+            break;
+        }
+
+        ++_expandedNodes;
+        _maxDistance = std::max(_maxDistance, distance);
+
+        for (auto i = 0; i < 4; ++i)
+        {
+            auto next = wrap({current.x + dirx[i], current.y + diry[i]});
+
+            if (!space.verifyAvailability(next)) { continue; }
+
+            auto nextDist = distance + _costMap.getStepCost(next, i % 2);
+            auto nextCurrentValue = getSearchMapValue(next);
+            if (nextCurrentValue == cSearchMapUnvisited
+                || nextCurrentValue > nextDist)
+            {
+                setTraceback(getIndex(next), current);
+                markSearchMap(next, nextDist);
+                _openSet.push(
+                    getIndex(next),
+                    nextDist + getHeuristic(next, end)
+                );
+            }
+        }
+    }
+
+    if (found)
+    {
+        trackbackAndStorePath(end);
+    }
+
+    return found;
+}
+
+CostMap& CostMapPlanner::getCostMap()
+{
+    return _costMap;
+}
+
+const CostMap& CostMapPlanner::getCostMap() const
+{
+    return _costMap;
+}
+
+int CostMapPlanner::getHeuristic(glm::ivec2 from, glm::ivec2 to) const
+{
+    auto dx = std::abs(from.x - to.x);
+    auto dy = std::abs(from.y - to.y);
+
+    return _costMap.getMinStepCost(0) * std::min(dx, _resolution - dx)
+        + _costMap.getMinStepCost(1) * std::min(dy, _resolution - dy);
+}
+
+}
@@ -0,0 +1,177 @@
+#include "DistanceField.hpp"
+
+#include <algorithm>
+
+namespace kinematic
+{
+
+namespace
+{
+    const int cDirX[] = {-1, 0, +1, 0};
+    const int cDirY[] = {0, -1, 0, +1};
+}
+
+const int DistanceField::cUnreachable = -1;
+
+DistanceField::DistanceField():
+    _space{nullptr},
+    _spaceRevision{0},
+    _valid{false},
+    _resolution{0},
+    _goal{0, 0},
+    _maxDistance{0},
+    _expandedNodes{0}
+{
+}
+
+DistanceField::~DistanceField()
+{
+}
+
+void DistanceField::create(const ConfigurationSpace& space, glm::ivec2 goal)
+{
+    _space = &space;
+    _spaceRevision = space.getRevision();
+    _valid = true;
+
+    _resolution = space.getResolution();
+    _goal = goal;
+    _maxDistance = 0;
+    _expandedNodes = 0;
+
+    const int cellCount = _resolution * _resolution;
+    _distances.assign(cellCount, cUnreachable);
+    _workspace.reset(cellCount);
+
+    if (!space.verifyAvailability(goal))
+    {
+        return;
+    }
+
+    std::uint32_t goalCell = getIndex(goal);
+    _distances[goalCell] = 0;
+    _workspace.visit(goalCell, 0);
+    _workspace.pushFrontier(goalCell);
+
+    while (!_workspace.isFrontierEmpty())
+    {
+        auto cell = _workspace.popFrontier();
+        auto nextDist = _distances[cell] + 1;
+        glm::ivec2 current{
+            static_cast<int>(cell) / _resolution,
+            static_cast<int>(cell) % _resolution
+        };
+
+        ++_expandedNodes;
+
+        for (auto i = 0; i < 4; ++i)
+        {
+            auto next = wrap({current.x + cDirX[i], current.y + cDirY[i]});
+            std::uint32_t nextCell = getIndex(next);
+
+            if (_workspace.isVisited(nextCell)) { continue; }
+            if (!space.verifyAvailability(next)) { continue; }
+
+            _workspace.visit(nextCell, i);
+            _workspace.pushFrontier(nextCell);
+            _distances[nextCell] = nextDist;
+            _maxDistance = std::max(_maxDistance, nextDist);
+        }
+    }
+}
+
+bool DistanceField::isValid(const ConfigurationSpace& space) const
+{
+    return _valid
+        && _space == &space
+        && _spaceRevision == space.getRevision()
+        && space.isAvailabilityMapCreated();
+}
+
+bool DistanceField::isValid(
+    const ConfigurationSpace& space,
+    glm::ivec2 goal
+) const
+{
+    return isValid(space) && _goal == goal;
+}
+
+void DistanceField::invalidate()
+{
+    _valid = false;
+}
+
+glm::ivec2 DistanceField::getGoal() const
+{
+    return _goal;
+}
+
+int DistanceField::getDistance(glm::ivec2 coord) const
+{
+    return _distances[getIndex(coord)];
+}
+
+int DistanceField::getMaxDistance() const
+{
+    return _maxDistance;
+}
+
+int DistanceField::getExpandedNodes() const
+{
+    return _expandedNodes;
+}
+
+const std::vector<int>& DistanceField::getDistances() const
+{
+    return _distances;
+}
+
+bool DistanceField::descend(
+    glm::ivec2 start,
+    std::vector<glm::ivec2>& path
+) const
+{
+    path.clear();
+
+    if (!_valid || getDistance(start) == cUnreachable)
+    {
+        return false;
+    }
+
+    auto current = start;
+    path.push_back(current);
+
+    for (auto distance = getDistance(start); distance > 0; --distance)
+    {
+        for (auto i = 0; i < 4; ++i)
+        {
+            auto next = wrap({current.x + cDirX[i], current.y + cDirY[i]});
+            if (getDistance(next) == distance - 1)
+            {
+                current = next;
+                break;
+            }
+        }
+
+        path.push_back(current);
+    }
+
+    return true;
+}
+
+glm::ivec2 DistanceField::wrap(glm::ivec2 coord) const
+{
+    glm::ivec2 wrapped{coord.x % _resolution, coord.y % _resolution};
+
+    if (wrapped.x < 0) { wrapped.x += _resolution; }
+    if (wrapped.y < 0) { wrapped.y += _resolution; }
+
+    return wrapped;
+}
+
+int DistanceField::getIndex(glm::ivec2 coord) const
+{
+    return _resolution * coord.x + coord.y;
+}
+
+}
@@ -0,0 +1,251 @@
+#include "InverseKinematics.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "SimdLanes.hpp"
+
+namespace kinematic
+{
+
+using namespace simd;
+
+namespace
+{
+    const float cPi = 3.14159265358979323846f;
+    const float cTanEighthPi = 0.41421356237f;
+    const float cMinDistance = 1.0e-30f;
+
+    // Arc tangent on [-tan(pi/8), tan(pi/8)], from Cephes' atanf.
+    const float cArcTangent[] = {
+        8.05374449538e-2f,
+        -1.38776856032e-1f,
+        1.99777106478e-1f,
+        -3.33329491539e-1f
+    };
+
+    // The angle is folded into [0, pi/8] before the polynomial, the same
+    // way on the vector path below.
+    float getArcTangent(float y, float x)
+    {
+        auto absX = std::fabs(x);
+        auto absY = std::fabs(y);
+        auto ratio = std::min(absX, absY)
+            / std::max(std::max(absX, absY), cMinDistance);
+
+        auto offset = 0.0f;
+        if (cTanEighthPi < ratio)
+        {
+            ratio = (ratio - 1.0f) / (ratio + 1.0f);
+            offset = 0.25f * cPi;
+        }
+
+        auto square = ratio * ratio;
+        auto polynomial = cArcTangent[0];
+        for (auto i = 1; i < 4; ++i)
+        {
+            polynomial = polynomial * square + cArcTangent[i];
+        }
+
+        auto angle = offset + polynomial * square * ratio + ratio;
+        if (absX < absY) { angle = 0.5f * cPi - angle; }
+        if (x < 0.0f) { angle = cPi - angle; }
+
+        return std::copysign(angle, y);
+    }
+
+#if defined(KINEMATIC_SIMD)
+    Lanes getArcTangent(Lanes y, Lanes x)
+    {
+        auto absX = absolute(x);
+        auto absY = absolute(y);
+        auto ratio = divide(
+            minimum(absX, absY),
+            maximum(maximum(absX, absY), broadcast(cMinDistance))
+        );
+
+        auto one = broadcast(1.0f);
+        auto folded = less(broadcast(cTanEighthPi), ratio);
+        ratio = blend(
+            folded,
+            divide(sub(ratio, one), add(ratio, one)),
+            ratio
+        );
+        auto offset = blend(
+            folded,
+            broadcast(0.25f * cPi),
+            broadcast(0.0f)
+        );
+
+        auto square = mul(ratio, ratio);
+        auto polynomial = broadcast(cArcTangent[0]);
+        for (auto i = 1; i < 4; ++i)
+        {
+            polynomial = add(
+                mul(polynomial, square),
+                broadcast(cArcTangent[i])
+            );
+        }
+
+        auto angle = add(
+            offset,
+            add(mul(mul(polynomial, square), ratio), ratio)
+        );
+        angle = blend(
+            less(absX, absY),
+            sub(broadcast(0.5f * cPi), angle),
+            angle
+        );
+        angle = blend(
+            less(x, broadcast(0.0f)),
+            sub(broadcast(cPi), angle),
+            angle
+        );
+
+        return copySign(angle, y);
+    }
+#endif
+}
+
+int solveInverseKinematics(
+    float firstArmLength,
+    float secondArmLength,
+    const float* targetX,
+    const float* targetY,
+    int count,
+    const InverseKinematicsBuffers& output
+)
+{
+    // The elbow lies where the circles of both links meet: `along` past
+    // the base towards the target and `across` to either side of that
+    // line. The beta of each solution follows from the cross and dot
+    // products of the two link directions.
+    auto firstSquared = firstArmLength * firstArmLength;
+    auto lengthDifference = firstSquared - secondArmLength * secondArmLength;
+    auto maxReach = firstArmLength + secondArmLength;
+    auto minReach = std::fabs(firstArmLength - secondArmLength);
+    auto maxSquared = maxReach * maxReach;
+    auto minSquared = minReach * minReach;
+
+    auto reachableCount = 0;
+    auto i = 0;
+
+#if defined(KINEMATIC_SIMD)
+    auto zero = broadcast(0.0f);
+    auto half = broadcast(0.5f);
+
+    for (; i + cLanes <= count; i += cLanes)
+    {
+        auto x = load(targetX + i);
+        auto y = load(targetY + i);
+
+        auto distanceSquared = add(mul(x, x), mul(y, y));
+        auto reachable = both(
+            both(less(zero, distanceSquared),
+                lessEqual(distanceSquared, broadcast(maxSquared))),
+            lessEqual(broadcast(minSquared), distanceSquared)
+        );
+
+        auto inverseDistance = divide(
+            broadcast(1.0f),
+            maximum(squareRoot(distanceSquared), broadcast(cMinDistance))
+        );
+        auto along = mul(
+            mul(add(distanceSquared, broadcast(lengthDifference)), half),
+            inverseDistance
+        );
+        auto across = squareRoot(maximum(
+            sub(broadcast(firstSquared), mul(along, along)),
+            zero
+        ));
+
+        auto directionX = mul(x, inverseDistance);
+        auto directionY = mul(y, inverseDistance);
+        auto alongX = mul(along, directionX);
+        auto alongY = mul(along, directionY);
+        auto acrossX = mul(across, directionY);
+        auto acrossY = mul(across, directionX);
+
+        for (auto side = 0; side < 2; ++side)
+        {
+            auto elbowX = side == 0
+                ? sub(alongX, acrossX)
+                : add(alongX, acrossX);
+            auto elbowY = side == 0
+                ? add(alongY, acrossY)
+                : sub(alongY, acrossY);
+            auto linkX = sub(x, elbowX);
+            auto linkY = sub(y, elbowY);
+
+            auto alpha = getArcTangent(elbowY, elbowX);
+            auto beta = getArcTangent(
+                sub(mul(elbowX, linkY), mul(elbowY, linkX)),
+                add(mul(elbowX, linkX), mul(elbowY, linkY))
+            );
+
+            store(output.alpha[side] + i, blend(reachable, alpha, zero));
+            store(output.beta[side] + i, blend(reachable, beta, zero));
+        }
+
+        auto bits = mask(reachable);
+        for (auto lane = 0; lane < cLanes; ++lane, bits >>= 1)
+        {
+            output.reachable[i + lane] = static_cast<unsigned char>(bits & 1);
+            reachableCount += bits & 1;
+        }
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        auto x = targetX[i];
+        auto y = targetY[i];
+
+        auto distanceSquared = x * x + y * y;
+        auto reachable = 0.0f < distanceSquared
+            && distanceSquared <= maxSquared
+            && minSquared <= distanceSquared;
+
+        output.reachable[i] = reachable ? 1 : 0;
+        if (!reachable)
+        {
+            for (auto side = 0; side < 2; ++side)
+            {
+                output.alpha[side][i] = 0.0f;
+                output.beta[side][i] = 0.0f;
+            }
+
+            continue;
+        }
+
+        ++reachableCount;
+
+        auto inverseDistance = 1.0f
+            / std::max(std::sqrt(distanceSquared), cMinDistance);
+        auto along = (distanceSquared + lengthDifference) * 0.5f
+            * inverseDistance;
+        auto across = std::sqrt(std::max(firstSquared - along * along, 0.0f));
+
+        auto directionX = x * inverseDistance;
+        auto directionY = y * inverseDistance;
+
+        for (auto side = 0; side < 2; ++side)
+        {
+            auto sign = side == 0 ? 1.0f : -1.0f;
+            auto elbowX = along * directionX - sign * across * directionY;
+            auto elbowY = along * directionY + sign * across * directionX;
+            auto linkX = x - elbowX;
+            auto linkY = y - elbowY;
+
+            output.alpha[side][i] = getArcTangent(elbowY, elbowX);
+            output.beta[side][i] = getArcTangent(
+                elbowX * linkY - elbowY * linkX,
+                elbowX * linkX + elbowY * linkY
+            );
+        }
+    }
+
+    return reachableCount;
+}
+
+}
@@ -0,0 +1,42 @@
+#include "JobProgress.hpp"
+
+namespace kinematic
+{
+
+JobProgress::JobProgress():
+    _progress{0.0f},
+    _cancelled{false}
+{
+}
+
+JobProgress::~JobProgress()
+{
+}
+
+void JobProgress::reset()
+{
+    _progress = 0.0f;
+    _cancelled = false;
+}
+
+void JobProgress::setProgress(float progress)
+{
+    _progress = progress;
+}
+
+float JobProgress::getProgress() const
+{
+    return _progress;
+}
+
+void JobProgress::cancel()
+{
+    _cancelled = true;
+}
+
+bool JobProgress::isCancelled() const
+{
+    return _cancelled;
+}
+
+}
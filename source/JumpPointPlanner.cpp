@@ -0,0 +1,386 @@
+#include "JumpPointPlanner.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <queue>
+
+namespace kinematic
+{
+
+namespace
+{
+    const int cHorizontal = 0;
+    const int cVertical = 1;
+
+    struct OpenNode
+    {
+        int estimate;
+        int heuristic;
+        int state;
+
+        bool operator>(const OpenNode& other) const
+        {
+            if (estimate != other.estimate)
+            {
+                return estimate > other.estimate;
+            }
+
+            return heuristic > other.heuristic;
+        }
+    };
+}
+
+JumpPointPlanner::JumpPointPlanner():
+    _space{nullptr},
+    _spaceRevision{0}
+{
+}
+
+JumpPointPlanner::~JumpPointPlanner()
+{
+}
+
+bool JumpPointPlanner::findPath(
+    const ConfigurationSpace& space,
+    glm::ivec2 start,
+    glm::ivec2 end
+)
+{
+    resetSearch(space.getResolution());
+    resetSearchMap();
+
+    // Jump points are kept per cell and per axis they were reached along,
+    // because the two axes prune their successors differently.
+    const int stateCount = 2 * _resolution * _resolution;
+    _stateDistance.resize(stateCount);
+    _stateParent.resize(stateCount);
+    _stateDirection.resize(stateCount);
+    resetStamps(_stateStamps, stateCount);
+    resetRowStops(space);
+
+    std::priority_queue<
+        OpenNode,
+        std::vector<OpenNode>,
+        std::greater<OpenNode>
+    > openSet;
+
+    auto startState = 2 * getIndex(start) + cVertical;
+    auto startHeuristic = getTorusDistance(start, end);
+    setStateDistance(startState, 0);
+    _stateParent[startState] = -1;
+    openSet.push({startHeuristic, startHeuristic, startState});
+    markSearchMap(start, 0);
+
+    auto push = [&](int parentState, glm::ivec2 from, glm::ivec2 step,
+        int axis, int steps)
+    {
+        if (steps == 0)
+        {
+            return;
+        }
+
+        auto jumpPoint = wrap(from + step * steps);
+        auto state = 2 * getIndex(jumpPoint) + axis;
+        auto distance = getStateDistance(parentState) + steps;
+        auto previous = getStateDistance(state);
+
+        if (previous != cSearchMapUnvisited && previous <= distance)
+        {
+            return;
+        }
+
+        setStateDistance(state, distance);
+        _stateParent[state] = parentState;
+        _stateDirection[state] = static_cast<signed char>(
+            axis == cHorizontal ? step.y : step.x
+        );
+
+        auto mapValue = getSearchMapValue(jumpPoint);
+        if (mapValue == cSearchMapUnvisited || mapValue > distance)
+        {
+            markSearchMap(jumpPoint, distance);
+        }
+
+        _maxDistance = std::max(_maxDistance, distance);
+
+        auto heuristic = getTorusDistance(jumpPoint, end);
+        openSet.push({distance + heuristic, heuristic, state});
+    };
+
+    auto endState = -1;
+    while (!openSet.empty())
+    {
+        auto node = openSet.top();
+        openSet.pop();
+
+        auto distance = getStateDistance(node.state);
+        if (node.estimate - node.heuristic != distance) { continue; }
+
+        auto index = node.state / 2;
+        auto axis = node.state % 2;
+        glm::ivec2 current{index / _resolution, index % _resolution};
+
+        if (current == end)
+        {
+            endState = node.state;
+            break;
+        }
+
+        ++_expandedNodes;
+
+        if (node.state == startState)
+        {
+            for (auto dir: {-1, +1})
+            {
+                push(node.state, current, {0, dir}, cHorizontal,
+                    jumpHorizontal(space, current, dir, end));
+                push(node.state, current, {dir, 0}, cVertical,
+                    jumpVertical(space, current, dir, end));
+            }
+
+            continue;
+        }
+
+        int dir = _stateDirection[node.state];
+        if (axis == cVertical)
+        {
+            push(node.state, current, {dir, 0}, cVertical,
+                jumpVertical(space, current, dir, end));
+
+            for (auto side: {-1, +1})
+            {
+                push(node.state, current, {0, side}, cHorizontal,
+                    jumpHorizontal(space, current, side, end));
+            }
+        }
+        else
+        {
+            push(node.state, current, {0, dir}, cHorizontal,
+                jumpHorizontal(space, current, dir, end));
+
+            for (auto side: {-1, +1})
+            {
+                if (hasForcedNeighbour(space, current, dir, side))
+                {
+                    push(node.state, current, {side, 0}, cVertical,
+                        jumpVertical(space, current, side, end));
+                }
+            }
+        }
+    }
+
+    if (endState < 0)
+    {
+        return false;
+    }
+
+    storeJumpPath(endState);
+    return true;
+}
+
+bool JumpPointPlanner::isFree(
+    const ConfigurationSpace& space,
+    glm::ivec2 coord
+) const
+{
+    return space.verifyAvailability(wrap(coord));
+}
+
+bool JumpPointPlanner::hasForcedNeighbour(
+    const ConfigurationSpace& space,
+    glm::ivec2 coord,
+    int diry,
+    int dirx
+) const
+{
+    return isFree(space, {coord.x + dirx, coord.y})
+        && !isFree(space, {coord.x + dirx, coord.y - diry});
+}
+
+int JumpPointPlanner::getStateDistance(int state) const
+{
+    return _stateStamps[state] == _searchGeneration
+        ? _stateDistance[state]
+        : cSearchMapUnvisited;
+}
+
+void JumpPointPlanner::setStateDistance(int state, int distance)
+{
+    _stateDistance[state] = distance;
+    _stateStamps[state] = _searchGeneration;
+}
+
+int JumpPointPlanner::jumpHorizontal(
+    const ConfigurationSpace& space,
+    glm::ivec2 from,
+    int diry,
+    glm::ivec2 end
+)
+{
+    if (!_rowFilled[from.x])
+    {
+        fillRowStops(space, from.x);
+    }
+
+    auto steps = _rowStops[getRowStopIndex(from, diry)];
+
+    // The goal ends a run as well, but is left out of the cached rows
+    // since it changes with every query.
+    if (end.x == from.x && end.y != from.y)
+    {
+        auto toEnd = (_resolution + diry * (end.y - from.y)) % _resolution;
+        if (toEnd <= steps)
+        {
+            return toEnd;
+        }
+    }
+
+    if (steps == _resolution
+        || !space.verifyAvailability(wrap({from.x, from.y + diry * steps})))
+    {
+        return 0;
+    }
+
+    return steps;
+}
+
+int JumpPointPlanner::jumpVertical(
+    const ConfigurationSpace& space,
+    glm::ivec2 from,
+    int dirx,
+    glm::ivec2 end
+)
+{
+    auto current = from;
+    for (auto steps = 1; steps < _resolution; ++steps)
+    {
+        current = wrap({current.x + dirx, current.y});
+
+        if (!space.verifyAvailability(current)) { return 0; }
+
+        if (current == end
+            || jumpHorizontal(space, current, -1, end) != 0
+            || jumpHorizontal(space, current, +1, end) != 0)
+        {
+            return steps;
+        }
+    }
+
+    return 0;
+}
+
+void JumpPointPlanner::resetRowStops(const ConfigurationSpace& space)
+{
+    const int tableSize = 2 * _resolution * _resolution;
+    if (_space == &space
+        && _spaceRevision == space.getRevision()
+        && static_cast<int>(_rowStops.size()) == tableSize)
+    {
+        return;
+    }
+
+    _space = &space;
+    _spaceRevision = space.getRevision();
+
+    _rowStops.resize(tableSize);
+    _rowFilled.assign(_resolution, false);
+}
+
+void JumpPointPlanner::fillRowStops(const ConfigurationSpace& space, int row)
+{
+    for (auto diry: {-1, +1})
+    {
+        auto getCell = [&](int i)
+        {
+            auto column = diry * (i % _resolution);
+            return glm::ivec2{row, (_resolution + column) % _resolution};
+        };
+
+        auto isStop = [&](glm::ivec2 cell)
+        {
+            return !space.verifyAvailability(cell)
+                || hasForcedNeighbour(space, cell, diry, -1)
+                || hasForcedNeighbour(space, cell, diry, +1);
+        };
+
+        // Each cell follows from the one ahead of it, so the row is walked
+        // backwards from just behind a stop. A row without stops never
+        // ends a run.
+        auto anchor = 0;
+        while (anchor < _resolution && !isStop(getCell(anchor + 1)))
+        {
+            ++anchor;
+        }
+
+        for (auto k = 0; k < _resolution; ++k)
+        {
+            auto cell = getCell(anchor - k + _resolution);
+            auto next = wrap({cell.x, cell.y + diry});
+
+            auto steps = _resolution;
+            if (anchor < _resolution)
+            {
+                steps = k == 0 || isStop(next)
+                    ? 1
+                    : std::min(
+                        _resolution,
+                        _rowStops[getRowStopIndex(next, diry)] + 1
+                    );
+            }
+
+            _rowStops[getRowStopIndex(cell, diry)] = steps;
+        }
+    }
+
+    _rowFilled[row] = true;
+}
+
+int JumpPointPlanner::getRowStopIndex(glm::ivec2 coord, int diry) const
+{
+    return (diry > 0 ? _resolution * _resolution : 0) + getIndex(coord);
+}
+
+void JumpPointPlanner::storeJumpPath(int endState)
+{
+    std::vector<glm::ivec2> newPath;
+
+    auto state = endState;
+    while (_stateParent[state] >= 0)
+    {
+        auto parentIndex = _stateParent[state] / 2;
+        glm::ivec2 parent{parentIndex / _resolution, parentIndex % _resolution};
+
+        auto index = state / 2;
+        glm::ivec2 current{index / _resolution, index % _resolution};
+
+        glm::ivec2 back = state % 2 == cHorizontal
+            ? glm::ivec2{0, -_stateDirection[state]}
+            : glm::ivec2{-_stateDirection[state], 0};
+
+        while (current != parent)
+        {
+            newPath.push_back(current);
+            current = wrap(current + back);
+        }
+
+        state = _stateParent[state];
+    }
+
+    auto startIndex = state / 2;
+    newPath.push_back({startIndex / _resolution, startIndex % _resolution});
+
+    _path.clear();
+    std::reverse_copy(
+        std::begin(newPath),
+        std::end(newPath),
+        std::back_inserter(_path)
+    );
+
+    for (auto i = 0u; i < _path.size(); ++i)
+    {
+        markSearchMap(_path[i], static_cast<int>(i));
+    }
+}
+
+}
@@ -0,0 +1,91 @@
+#include "KinematicChain.hpp"
+
+#include <cmath>
+#include <numeric>
+
+namespace kinematic
+{
+
+KinematicChain::KinematicChain():
+    _linkLengths{0.3f, 0.3f}
+{
+}
+
+KinematicChain::~KinematicChain()
+{
+}
+
+void KinematicChain::setLinkLengths(const std::vector<float>& linkLengths)
+{
+    _linkLengths = linkLengths;
+}
+
+const std::vector<float>& KinematicChain::getLinkLengths() const
+{
+    return _linkLengths;
+}
+
+int KinematicChain::getJointCount() const
+{
+    return static_cast<int>(_linkLengths.size());
+}
+
+float KinematicChain::getReach() const
+{
+    return std::accumulate(
+        std::begin(_linkLengths),
+        std::end(_linkLengths),
+        0.0f
+    );
+}
+
+void KinematicChain::computeJointPositions(
+    const float* angles,
+    glm::vec2* positions
+) const
+{
+    glm::vec2 position{0.0f, 0.0f};
+    float heading = 0.0f;
+
+    positions[0] = position;
+    for (auto joint = 0; joint < getJointCount(); ++joint)
+    {
+        heading += angles[joint];
+        position += _linkLengths[joint]
+            * glm::vec2{std::cos(heading), std::sin(heading)};
+        positions[joint + 1] = position;
+    }
+}
+
+void KinematicChain::computeJointPositions(
+    const float* angles,
+    int count,
+    float* x,
+    float* y
+) const
+{
+    std::vector<float> headings(count, 0.0f);
+
+    for (auto i = 0; i < count; ++i)
+    {
+        x[i] = 0.0f;
+        y[i] = 0.0f;
+    }
+
+    for (auto joint = 0; joint < getJointCount(); ++joint)
+    {
+        auto length = _linkLengths[joint];
+        auto jointAngles = angles + joint * count;
+        auto previousX = x + joint * count, previousY = y + joint * count;
+        auto nextX = previousX + count, nextY = previousY + count;
+
+        for (auto i = 0; i < count; ++i)
+        {
+            headings[i] += jointAngles[i];
+            nextX[i] = previousX[i] + length * std::cos(headings[i]);
+            nextY[i] = previousY[i] + length * std::sin(headings[i]);
+        }
+    }
+}
+
+}
@@ -1,8 +1,8 @@
 #include "KinematicChainApplication.hpp"
 
 #include <iostream>
-#include <queue>
 
+#include "glm/gtc/constants.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 #include "glm/gtc/type_ptr.hpp"
 #define GLM_ENABLE_EXPERIMENTAL
@@ -11,21 +11,71 @@
 #include "imgui.h"
 
 #include "fw/Common.hpp"
-#include "fw/DebugShapes.hpp"
 #include "fw/Resources.hpp"
-#include "fw/GeometricIntersections.hpp"
 
 namespace kinematic
 {
 
+namespace
+{
+    std::vector<JointVector> getCellPath(
+        const ConfigurationSpace& space,
+        const std::vector<glm::ivec2>& cells
+    )
+    {
+        std::vector<JointVector> path;
+        path.reserve(cells.size());
+
+        for (const auto& cell: cells)
+        {
+            auto angles = space.getCellAngles(cell);
+            path.push_back({angles.x, angles.y});
+        }
+
+        return path;
+    }
+
+    // Smooths the path when given a smoother and splits it finely enough
+    // to draw. Runs on planning jobs, before the path is stored.
+    std::vector<JointVector> refineMotionPath(
+        PathSmoother* smoother,
+        const ChainConfigurationSpace& space,
+        std::vector<JointVector> path,
+        float step
+    )
+    {
+        if (smoother != nullptr)
+        {
+            smoother->smooth(space, path);
+        }
+
+        return PathSmoother::resample(path, step);
+    }
+}
+
 KinematicChainApplication::KinematicChainApplication():
+    _availabilityMapCreated{false},
+    _availabilityMapTexture{0},
+    _availabilityMapRevision{0},
+    _configurationSpaceResolution{360},
+    _pathPlannerKind{0},
+    _chainPlannerKind{0},
+    _jointCount{2},
+    _chainStart{0.0f, 0.0f},
+    _chainEnd{0.0f, 0.0f},
+    _chainPathFailed{false},
+    _pathSmoothingEnabled{true},
+    _reachabilityEnabled{false},
+    _reachabilityTexture{0},
     _searchMapAvailable{false},
+    _searchMapTexture{0},
     _selectedConstraint{-1},
     _isConstraintGrabbed{false},
-    _frameTime{0.25f},
     _animationEnabled{false},
-    _frameAnimationPassed{0.0f},
-    _currentAnimationStep{0}
+    _ghostsEnabled{false},
+    _animationTime{0.0f},
+    _jointVelocityLimit{Trajectory::cDefaultVelocityLimit},
+    _jointAccelerationLimit{Trajectory::cDefaultAccelerationLimit}
 {
 }
 
@@ -39,20 +89,48 @@ void KinematicChainApplication::onCreate()
 
     _standard2DEffect = std::make_shared<fw::Standard2DEffect>();
 
-    _quadGeometry = fw::createQuad2D({1.0f, 1.0f});
+    _quadBatch = std::make_shared<QuadBatch>();
+    _quadBatch->create();
+    _ghostBatch = std::make_shared<QuadBatch>();
+    _ghostBatch->create();
 
     _armController = std::make_shared<RoboticArmController>();
     _armRendering = std::make_shared<RoboticArmRendering>();
 
+    _jobThreadPool = std::make_shared<ThreadPool>();
+    _mapJob = std::make_shared<BackgroundJob>();
+    _planningJob = std::make_shared<BackgroundJob>();
+    _reachabilityJob = std::make_shared<BackgroundJob>();
+
+    _configurationSpace = std::make_shared<ConfigurationSpace>();
+    _planningSpace = std::make_shared<ConfigurationSpace>();
+    _planningSpace->setThreadPool(_jobThreadPool);
+    _planningChainSpace = std::make_shared<ChainConfigurationSpace>();
+    _planningChainSpace->setObstacles(_planningSpace);
+    _goalField = std::make_shared<DistanceField>();
+    _costMapPlanner = std::make_shared<CostMapPlanner>();
+    _reachabilityMap = std::make_shared<ReachabilityMap>();
+    createPathPlanner();
+
+    _chainSpace = std::make_shared<ChainConfigurationSpace>();
+    createChainPlanner();
+    _pathSmoother = std::make_shared<PathSmoother>();
+    _trajectory = std::make_shared<Trajectory>();
+
     _testTexture = std::make_shared<fw::Texture>(
         fw::getFrameworkResourcePath("textures/checker-base.png")
     );
 
-    _constraints.push_back({{-1.0, -1.0},{-0.5, -0.5}});
+    _configurationSpace->addConstraint({{-1.0, -1.0},{-0.5, -0.5}});
 }
 
 void KinematicChainApplication::onDestroy()
 {
+    _mapJob->cancel();
+    _planningJob->cancel();
+    _reachabilityJob->cancel();
+    _quadBatch->destroy();
+    _ghostBatch->destroy();
     ImGuiApplication::onDestroy();
 }
 
@@ -63,18 +141,30 @@ void KinematicChainApplication::onUpdate(
     ImGuiApplication::onUpdate(deltaTime);
     _armController->update(deltaTime);
 
+    _mapJob->poll();
+    _planningJob->poll();
+    _reachabilityJob->poll();
+
+    if (_armController->getJointCount() != _jointCount)
+    {
+        _planningJob->cancel();
+        _jointCount = _armController->getJointCount();
+        _chainStart.assign(_jointCount, 0.0f);
+        _chainEnd.assign(_jointCount, 0.0f);
+        resetPaths();
+    }
+
     if (ImGui::CollapsingHeader("Constraints"))
     {
         ImGui::Text("Select constraints by clicking, move by dragging");
 
         if (ImGui::Button("New"))
         {
-            _constraints.push_back({
+            _selectedConstraint = _configurationSpace->addConstraint({
                 {-0.5f, -0.5f},
                 {0.5f, 0.5f}
             });
-
-            _selectedConstraint = _constraints.size() - 1;
+            onConstraintsChanged();
         }
 
         if (_selectedConstraint >= 0)
@@ -82,18 +172,16 @@ void KinematicChainApplication::onUpdate(
             ImGui::SameLine();
             if (ImGui::Button("Delete"))
             {
-                std::swap(
-                    _constraints.back(),
-                    _constraints[_selectedConstraint]
-                );
-                _constraints.pop_back();
+                _configurationSpace->removeConstraint(_selectedConstraint);
                 _selectedConstraint = -1;
+                onConstraintsChanged();
             }
             else
             {
-                auto& selected = _constraints[_selectedConstraint];
+                auto selected =
+                    _configurationSpace->getConstraints()[_selectedConstraint];
                 auto size = selected.max - selected.min;
-                ImGui::DragFloat2(
+                auto sizeChanged = ImGui::DragFloat2(
                     "Size",
                     glm::value_ptr(size),
                     0.05f,
@@ -101,19 +189,46 @@ void KinematicChainApplication::onUpdate(
                     10.0f
                 );
 
-                auto center = (selected.min + selected.max) / 2.0f;
-                selected.min = center - size * 0.5f;
-                selected.max = center + size * 0.5f;
+                if (sizeChanged)
+                {
+                    auto center = (selected.min + selected.max) / 2.0f;
+                    selected.min = center - size * 0.5f;
+                    selected.max = center + size * 0.5f;
+                    _configurationSpace->setConstraint(
+                        _selectedConstraint,
+                        selected
+                    );
+                    onConstraintsChanged();
+                }
             }
         }
     }
 
+    if (!_configurationSpace->isAvailabilityMapCreated())
+    {
+        _availabilityMapCreated = false;
+    }
+    else if (_configurationSpace->getRevision() != _availabilityMapRevision)
+    {
+        createAvailabilityMapTexture();
+    }
+
     if (ImGui::CollapsingHeader("Configuration space"))
     {
-        if (ImGui::Button("Calculate"))
+        ImGui::SliderInt(
+            "Cells per turn",
+            &_configurationSpaceResolution,
+            36,
+            3600
+        );
+
+        if (_mapJob->isRunning())
+        {
+            showJobProgress(*_mapJob, "Cancel##map");
+        }
+        else if (ImGui::Button("Calculate"))
         {
             createAvailabilityMap();
-            _availabilityMapCreated = true;
         }
 
         if (_availabilityMapCreated)
@@ -143,7 +258,19 @@ void KinematicChainApplication::onUpdate(
         }
     }
 
-    if (ImGui::CollapsingHeader("Path finding"))
+    if (_jointCount == 2 && ImGui::CollapsingHeader("Reachability"))
+    {
+        showReachability();
+    }
+
+    if (_jointCount != 2)
+    {
+        if (ImGui::CollapsingHeader("Chain path finding"))
+        {
+            showChainPathFinding();
+        }
+    }
+    else if (ImGui::CollapsingHeader("Path finding"))
     {
         ImGui::DragFloat2(
             "Start conf",
@@ -180,19 +307,68 @@ void KinematicChainApplication::onUpdate(
             }
         }
 
-        if (_availabilityMapCreated)
+        if (_planningJob->isRunning())
         {
-            if (ImGui::Button("Find path"))
-            {
-                findPath();
-            }
+            showJobProgress(*_planningJob, "Cancel##planning");
         }
         else
         {
-            ImGui::TextColored(
-                {1.0f, 0.0f, 0.0f, 1.0f},
-                "Path cannot be found without configuration space generated."
-            );
+            const char* plannerNames[] = {
+                "Breadth-first",
+                "A*",
+                "Jump point search",
+                "Bidirectional breadth-first",
+                "Multi-query roadmap",
+                "8-connected A*",
+                "Theta* (any-angle)",
+                "Cost map A*"
+            };
+
+            if (ImGui::Combo("Planner", &_pathPlannerKind, plannerNames, 8))
+            {
+                createPathPlanner();
+            }
+
+            if (_pathPlannerKind == 7)
+            {
+                showCostMapSettings();
+            }
+
+            ImGui::Checkbox("Smooth path", &_pathSmoothingEnabled);
+
+            if (_availabilityMapCreated)
+            {
+                if (ImGui::Button("Find path"))
+                {
+                    findPath();
+                }
+
+                ImGui::SameLine();
+                if (ImGui::Button("Go to end conf"))
+                {
+                    goToEndConfiguration();
+                }
+
+                auto goalFieldReady = _planningSpace->getRevision()
+                        == _configurationSpace->getRevision()
+                    && _goalField->isValid(*_planningSpace);
+
+                if (goalFieldReady)
+                {
+                    ImGui::Text(
+                        "Distance field ready (%d cells)",
+                        _goalField->getExpandedNodes()
+                    );
+                }
+            }
+            else
+            {
+                ImGui::TextColored(
+                    {1.0f, 0.0f, 0.0f, 1.0f},
+                    "Path cannot be found without configuration space "
+                        "generated."
+                );
+            }
         }
 
         if (_searchMapAvailable)
@@ -218,49 +394,62 @@ void KinematicChainApplication::onUpdate(
 
             glBindTexture(GL_TEXTURE_2D, 0);
 
+            ImGui::Text(
+                "Expanded nodes: %d",
+                _pathPlanner->getExpandedNodes()
+            );
             showTexturePreview(_searchMapTexture, w, h);
         }
     }
 
     if (_animationEnabled)
     {
-        _frameAnimationPassed +=
-            std::chrono::duration<float>(deltaTime).count();
-
-        while (_frameAnimationPassed > _frameTime)
-        {
-            ++_currentAnimationStep;
-            _frameAnimationPassed -= _frameTime;
-        }
+        _animationTime += std::chrono::duration<float>(deltaTime).count();
 
-        if (_currentAnimationStep + 1 >= _configurationPath.size())
+        if (_animationTime >= _trajectory->getDuration())
         {
             _animationEnabled = false;
-            _currentAnimationStep = 0;
-            _frameAnimationPassed = 0.0f;
+            _animationTime = 0.0f;
         }
     }
 
-    if (_configurationPath.size() > 0 && ImGui::CollapsingHeader("Animation"))
+    if (!_trajectory->isEmpty() && ImGui::CollapsingHeader("Animation"))
     {
-        ImGui::SliderFloat("Time per frame", &_frameTime, 0.05f, 2.0f);
+        auto limitsChanged = ImGui::SliderFloat(
+            "Joint speed limit",
+            &_jointVelocityLimit,
+            0.1f,
+            10.0f
+        );
+        limitsChanged |= ImGui::SliderFloat(
+            "Joint acceleration limit",
+            &_jointAccelerationLimit,
+            0.1f,
+            40.0f
+        );
 
-        if (_currentAnimationStep > 0 && ImGui::Button("Restart"))
+        if (limitsChanged)
         {
-            _currentAnimationStep = 0;
-            _frameAnimationPassed = 0.0f;
+            createTrajectory();
+        }
+
+        ImGui::Text("Duration: %.2f s", _trajectory->getDuration());
+
+        if (_animationTime > 0.0f && ImGui::Button("Restart"))
+        {
+            _animationTime = 0.0f;
         }
 
         if (!_animationEnabled && ImGui::Button("Play"))
         {
-            if (_currentAnimationStep >= _configurationPath.size())
-                _currentAnimationStep = 0;
             _animationEnabled = true;
         }
         else if (_animationEnabled && ImGui::Button("Stop"))
         {
             _animationEnabled = false;
         }
+
+        ImGui::Checkbox("Show path ghosts", &_ghostsEnabled);
     }
 }
 
@@ -271,54 +460,58 @@ void KinematicChainApplication::onRender()
 
     auto projection = getProjection();
 
-    glm::vec3 primaryColor{0.0f, 1.0f, 1.0f};
-    glm::vec3 secondaryColor{0.3f, 0.3f, 0.3f};
+    glm::vec4 primaryColor{0.0f, 1.0f, 1.0f, 1.0f};
+    glm::vec4 secondaryColor{0.3f, 0.3f, 0.3f, 1.0f};
 
+    // The ghosts only change with the path, so their batch keeps its
+    // upload between frames.
+    if (_ghostsEnabled && !_trajectory->isEmpty())
+    {
+        _ghostBatch->render(projection);
+    }
 
-    auto solutions = getValidSolutions();
+    // Arms, obstacles and the target all go into one batch, drawn with a
+    // single call in the order they are added.
+    _quadBatch->clear();
 
-    if (solutions.size() > 1)
+    if (_jointCount != 2)
     {
-        _standard2DEffect->setEmissionColor(secondaryColor);
+        auto pose = getChainPose();
+        syncChainSpace();
+
+        addArm(
+            pose,
+            _chainSpace->checkConfiguration(pose)
+                ? primaryColor
+                : secondaryColor
+        );
     }
     else
     {
-        _standard2DEffect->setEmissionColor(primaryColor);
-    }
-
-
-    for (auto it = solutions.rbegin(); it != solutions.rend(); ++it)
-    {
-        const auto& solution = *it;
-
-        _armRendering->setFirstArmLength(_armController->getFirstArmLength());
-        _armRendering->setSecondArmLength(_armController->getSecondArmLength());
-        _armRendering->setArmsThickness(_armController->getVisualThickness());
-        _armRendering->setAlphaAngle(solution.first);
-        _armRendering->setBetaAngle(solution.second);
+        auto solutions = getValidSolutions();
+        auto color = solutions.size() > 1 ? secondaryColor : primaryColor;
 
-        for (const auto& chunk: _armRendering->render())
+        for (auto it = solutions.rbegin(); it != solutions.rend(); ++it)
         {
-            _standard2DEffect->setModelMatrix(chunk.getModelMatrix());
-            _standard2DEffect->setViewMatrix({});
-            _standard2DEffect->setProjectionMatrix(projection);
-            _standard2DEffect->setDiffuseTexture(_testTexture->getTextureId());
-            _standard2DEffect->begin();
-            chunk.getMesh()->render();
-            _standard2DEffect->end();
+            addArm({it->first, it->second}, color);
+            color = primaryColor;
         }
-
-        _standard2DEffect->setEmissionColor(primaryColor);
     }
 
-    for (const auto& constraint: _constraints)
+    for (const auto& constraint: _configurationSpace->getConstraints())
     {
         glm::vec2 position = (constraint.min + constraint.max) / 2.0f;
         glm::vec2 size = constraint.max - constraint.min;
-        drawQuad(position, size, {1.0f, 0.3f, 0.3f});
+        _quadBatch->addQuad(position, size, {1.0f, 0.3f, 0.3f, 1.0f});
     }
 
-    drawQuad(_armController->getTarget(), {0.01, 0.01}, {0.0f, 1.0f, 0.0f});
+    _quadBatch->addQuad(
+        _armController->getTarget(),
+        {0.01f, 0.01f},
+        {0.0f, 1.0f, 0.0f, 1.0f}
+    );
+
+    _quadBatch->render(projection);
 
     if (_line != nullptr)
     {
@@ -326,6 +519,7 @@ void KinematicChainApplication::onRender()
         _standard2DEffect->setModelMatrix({});
         _standard2DEffect->setViewMatrix({});
         _standard2DEffect->setProjectionMatrix(projection);
+        _standard2DEffect->setDiffuseTexture(_testTexture->getTextureId());
         _standard2DEffect->begin();
         _line->render();
         _standard2DEffect->end();
@@ -371,9 +565,13 @@ bool KinematicChainApplication::onMouseMove(glm::dvec2 newPosition)
     {
         auto newWorldPosition = getWorldCursorPos(newPosition);
         auto delta = newWorldPosition - _previousGrabWorldPosition;
-        _constraints[_selectedConstraint].min += delta;
-        _constraints[_selectedConstraint].max += delta;
+        auto moved =
+            _configurationSpace->getConstraints()[_selectedConstraint];
+        moved.min += delta;
+        moved.max += delta;
+        _configurationSpace->setConstraint(_selectedConstraint, moved);
         _previousGrabWorldPosition = newWorldPosition;
+        onConstraintsChanged();
     }
 
     return false;
@@ -393,11 +591,17 @@ bool KinematicChainApplication::onResize()
 }
 
 glm::mat4 KinematicChainApplication::getProjection() const
+{
+    auto area = getVisibleArea();
+    return glm::ortho(area.min.x, area.max.x, area.min.y, area.max.y);
+}
+
+fw::AABB<glm::vec2> KinematicChainApplication::getVisibleArea() const
 {
     auto framebufferSize = getFramebufferSize();
     auto aspectRatio =
         static_cast<float>(framebufferSize.x) / framebufferSize.y;
-    return glm::ortho(-aspectRatio, aspectRatio, -1.0f, 1.0f);
+    return {{-aspectRatio, -1.0f}, {aspectRatio, 1.0f}};
 }
 
 glm::vec2 KinematicChainApplication::getWorldCursorPos(
@@ -422,121 +626,114 @@ bool KinematicChainApplication::grabConstraint()
 {
     auto worldCursorPos = getWorldCursorPos(getCurrentMousePosition());
 
-    for (auto i = 0; i < _constraints.size(); ++i)
+    auto index = _configurationSpace->findConstraint(worldCursorPos);
+    if (index < 0)
     {
-        if (_constraints[i].contains(worldCursorPos))
-        {
-            _selectedConstraint = i;
-            _isConstraintGrabbed = true;
-            _previousGrabWorldPosition = worldCursorPos;
-            return true;
-        }
+        return false;
     }
 
-    return false;
+    _selectedConstraint = index;
+    _isConstraintGrabbed = true;
+    _previousGrabWorldPosition = worldCursorPos;
+    return true;
 }
 
-bool KinematicChainApplication::checkArmConstraintCollision(
-    glm::vec2 start,
-    glm::vec2 end
-) const
+void KinematicChainApplication::createAvailabilityMap()
 {
-    for (const auto& constraint: _constraints)
-    {
-        if (checkSegmentAABBCollision(start, end, constraint))
+    // The map is built into a space of its own on a worker, while the
+    // current one stays on screen and keeps taking obstacle edits. The
+    // build runs on a pool of its own so those edits never wait for it.
+    auto space = std::make_shared<ConfigurationSpace>();
+    space->setThreadPool(_jobThreadPool);
+    space->setArmLengths(
+        _armController->getFirstArmLength(),
+        _armController->getSecondArmLength()
+    );
+    space->setResolution(_configurationSpaceResolution);
+    space->setConstraints(_configurationSpace->getConstraints());
+
+    _mapJob->start(
+        [space](JobProgress& progress)
         {
-            return true;
+            return space->createAvailabilityMap(&progress);
+        },
+        [this, space]()
+        {
+            publishAvailabilityMap(space);
         }
-    }
-
-    return false;
+    );
 }
 
-bool KinematicChainApplication::checkSegmentAABBCollision(
-    const glm::vec2& start,
-    const glm::vec2& end,
-    const fw::AABB<glm::vec2>& aabb
-) const
+void KinematicChainApplication::publishAvailabilityMap(
+    std::shared_ptr<ConfigurationSpace> space
+)
 {
-    if (aabb.contains(start) || aabb.contains(end))
-    {
-        return true;
-    }
-
-    auto pmin = aabb.min;
-    auto pmax = aabb.max;
-    glm::vec2 pminmax{pmin.x, pmax.y};
-    glm::vec2 pmaxmin{pmax.x, pmin.y};
-
-    return
-        fw::intersectSegments<glm::vec2, float>(
-            start,
-            end,
-            pmin,
-            pmaxmin
-        ).kind != fw::GeometricIntersectionKind::None
-        || fw::intersectSegments<glm::vec2, float>(
-            start,
-            end,
-            pmin,
-            pminmax
-        ).kind != fw::GeometricIntersectionKind::None
-        || fw::intersectSegments<glm::vec2, float>(
-            start,
-            end,
-            pmax,
-            pminmax
-        ).kind != fw::GeometricIntersectionKind::None
-        || fw::intersectSegments<glm::vec2, float>(
-            start,
-            end,
-            pmin,
-            pmaxmin
-        ).kind != fw::GeometricIntersectionKind::None;
-}
+    // Plans still running were made on the map being replaced.
+    _planningJob->cancel();
 
-void KinematicChainApplication::createAvailabilityMap()
-{
-    _availabilityMap.clear();
-    for (auto alphaStep = 0; alphaStep < 360; ++alphaStep)
+    if (space->getResolution() != _configurationSpace->getResolution())
     {
-        float alpha = glm::radians(static_cast<float>(alphaStep));
-        for (auto betaStep = 0; betaStep < 360; ++betaStep)
-        {
-            float beta = glm::radians(static_cast<float>(betaStep));
-            _availabilityMap.push_back(checkConfiguration(alpha, beta));
-        }
+        resetPaths();
+        _searchMapAvailable = false;
     }
 
+    space->setThreadPool(_configurationSpace->getThreadPool());
+    _configurationSpace = space;
     createAvailabilityMapTexture();
 }
 
 void KinematicChainApplication::createAvailabilityMapTexture()
 {
+    const auto& grid = _configurationSpace->getOccupancyGrid();
+
     std::vector<unsigned char> image;
-    for (const auto& state: _availabilityMap)
+    image.reserve(3 * grid.getRows() * grid.getColumns());
+    for (auto row = 0; row < grid.getRows(); ++row)
     {
-        if (state)
+        for (auto column = 0; column < grid.getColumns(); ++column)
         {
-            image.push_back(0);
-            image.push_back(255);
-            image.push_back(0);
-        }
-        else
-        {
-            image.push_back(255);
-            image.push_back(0);
-            image.push_back(0);
+            if (!grid.isOccupied(row, column))
+            {
+                image.push_back(0);
+                image.push_back(255);
+                image.push_back(0);
+            }
+            else
+            {
+                image.push_back(255);
+                image.push_back(0);
+                image.push_back(0);
+            }
         }
     }
 
-    glGenTextures(1, &_availabilityMapTexture);
+    if (_availabilityMapTexture == 0)
+    {
+        glGenTextures(1, &_availabilityMapTexture);
+    }
+
     glBindTexture(GL_TEXTURE_2D, _availabilityMapTexture);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 360, 360, 0,
+    auto resolution = _configurationSpace->getResolution();
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, resolution, resolution, 0,
         GL_RGB, GL_UNSIGNED_BYTE, image.data());
     glBindTexture(GL_TEXTURE_2D, 0);
+
+    _availabilityMapCreated = true;
+    _availabilityMapRevision = _configurationSpace->getRevision();
+}
+
+void KinematicChainApplication::onConstraintsChanged()
+{
+    // Plans for the old obstacles are dropped, and a map being built for
+    // them starts over.
+    _planningJob->cancel();
+
+    if (_mapJob->isRunning() && !_mapJob->isCancelled())
+    {
+        createAvailabilityMap();
+    }
 }
 
 std::vector<std::pair<float, float>>
@@ -544,17 +741,8 @@ std::vector<std::pair<float, float>>
 {
     if (_animationEnabled)
     {
-        auto from = glm::vec2{_configurationPath[_currentAnimationStep]};
-        auto to = glm::vec2{_configurationPath[_currentAnimationStep + 1]};
-
-        float t = std::min(1.0f, _frameAnimationPassed / _frameTime);
-        auto mixed = glm::vec2{
-            mixDegrees(from.x, to.x, t),
-            mixDegrees(from.y, to.y, t),
-        };
-
-        mixed = glm::radians(mixed);
-        return {{mixed.x, mixed.y}};
+        auto pose = getChainPose();
+        return {{pose[0], pose[1]}};
     }
 
     std::vector<std::pair<float, float>> output;
@@ -568,53 +756,25 @@ std::vector<std::pair<float, float>>
     return output;
 }
 
-float KinematicChainApplication::mixDegrees(float a, float b, float m)
-{
-    auto lengthDirect = std::abs(b - a);
-    auto lengthAround = std::min(a, b) + (360.0f - std::max(a, b));
-
-    if (lengthDirect < lengthAround)
-    {
-        return glm::mix(a, b, m);
-    }
-
-    if (a < b)
-    {
-        return glm::mix(a, b - 360.0f, m);
-    }
-    else
-    {
-        return glm::mix(a, b + 360.0f, m);
-    }
-}
-
 bool KinematicChainApplication::checkConfiguration(float alpha, float beta)
 {
-    auto config = _armController->buildConfiguration(alpha, beta);
-    return !(checkArmConstraintCollision({0, 0}, config.first)
-        || checkArmConstraintCollision(config.first, config.second));
+    _configurationSpace->setArmLengths(
+        _armController->getFirstArmLength(),
+        _armController->getSecondArmLength()
+    );
+
+    return _configurationSpace->checkConfiguration(alpha, beta);
 }
 
-void KinematicChainApplication::drawQuad(
-    const glm::vec2& position,
-    const glm::vec2& size,
-    const glm::vec3& color
+void KinematicChainApplication::addArm(
+    const JointVector& angles,
+    const glm::vec4& color
 )
 {
-    _standard2DEffect->setEmissionColor(color);
-    _standard2DEffect->setViewMatrix({});
-    _standard2DEffect->setModelMatrix(glm::scale(
-        glm::translate(
-            glm::mat4{},
-            glm::vec3{position, 0.0}
-        ),
-        glm::vec3{size, 1.0}
-    ));
-    _standard2DEffect->setProjectionMatrix(getProjection());
-    _standard2DEffect->setDiffuseTexture(_testTexture->getTextureId());
-    _standard2DEffect->begin();
-    _quadGeometry->render();
-    _standard2DEffect->end();
+    _armRendering->setChain(_armController->getChain());
+    _armRendering->setArmsThickness(_armController->getVisualThickness());
+    _armRendering->setJointAngles(angles);
+    _armRendering->render(*_quadBatch, color);
 }
 
 void KinematicChainApplication::showTexturePreview(
@@ -665,11 +825,15 @@ void KinematicChainApplication::showTexturePreview(
             focus_y = h - focus_sz;
         }
 
-        ImGui::Text("Min: alpha=%.2f, beta=%.2f", focus_y, focus_x);
+        ImGui::Text(
+            "Min: alpha=%.2f, beta=%.2f",
+            focus_y * 360.0f / h,
+            focus_x * 360.0f / w
+        );
         ImGui::Text(
             "Max: alpha=%.2f, beta=%.2f",
-            focus_y + focus_sz,
-            focus_x + focus_sz
+            (focus_y + focus_sz) * 360.0f / h,
+            (focus_x + focus_sz) * 360.0f / w
         );
 
         ImVec2 uv0{(focus_x) / w, (focus_y) / h};
@@ -687,106 +851,333 @@ void KinematicChainApplication::showTexturePreview(
     }
 }
 
-glm::ivec2 KinematicChainApplication::getClosestInConfiguration(
-    glm::vec2 coord
+void KinematicChainApplication::showJobProgress(
+    BackgroundJob& job,
+    const char* cancelLabel
 )
 {
-    auto degrees = glm::degrees(coord);
-    glm::vec2 clamped{
-        static_cast<int>(std::round(degrees.x)) % 360,
-        static_cast<int>(std::round(degrees.y)) % 360
-    };
+    ImGui::ProgressBar(job.getProgress());
 
-    if (clamped.x < 0) { clamped.x += 360; }
-    if (clamped.y < 0) { clamped.y += 360; }
+    if (job.isCancelled())
+    {
+        ImGui::Text("Cancelling...");
+    }
+    else if (ImGui::Button(cancelLabel))
+    {
+        job.cancel();
+    }
+}
 
-    return clamped;
+void KinematicChainApplication::createPathPlanner()
+{
+    switch (_pathPlannerKind)
+    {
+    case 1:
+        _pathPlanner = std::make_shared<AStarPlanner>();
+        break;
+    case 2:
+        _pathPlanner = std::make_shared<JumpPointPlanner>();
+        break;
+    case 3:
+        _pathPlanner = std::make_shared<BidirectionalPlanner>();
+        break;
+    case 4:
+        _pathPlanner = std::make_shared<MultiQueryPlanner>();
+        break;
+    case 5:
+    {
+        auto planner = std::make_shared<ThetaStarPlanner>();
+        planner->setAnyAngle(false);
+        _pathPlanner = planner;
+        break;
+    }
+    case 6:
+        _pathPlanner = std::make_shared<ThetaStarPlanner>();
+        break;
+    case 7:
+        _pathPlanner = _costMapPlanner;
+        break;
+    default:
+        _pathPlanner = std::make_shared<BreadthFirstPlanner>();
+        break;
+    }
+
+    _searchMapAvailable = false;
 }
 
-void KinematicChainApplication::findPath()
+void KinematicChainApplication::showCostMapSettings()
 {
-    auto startDeg = getClosestInConfiguration(_startConfiguration);
-    auto endDeg = getClosestInConfiguration(_endConfiguration);
+    auto& costMap = _costMapPlanner->getCostMap();
+
+    auto jointWeights = costMap.getJointWeights();
+    auto jointWeightsChanged = ImGui::SliderFloat2(
+        "Joint weights",
+        glm::value_ptr(jointWeights),
+        0.1f,
+        4.0f
+    );
 
-    const int cSearchMapMax = 360 * 360 + 1;
-    _searchMap.resize(360*360);
-    std::fill(std::begin(_searchMap), std::end(_searchMap), cSearchMapMax);
+    if (jointWeightsChanged)
+    {
+        costMap.setJointWeights(jointWeights);
+    }
 
-    _searchMapTraceback.resize(360*360);
-    for (auto& el: _searchMapTraceback)
+    auto clearanceRange = costMap.getClearanceRange();
+    if (ImGui::SliderInt("Clearance range", &clearanceRange, 1, 64))
     {
-        el = glm::ivec2{-1, -1};
+        costMap.setClearanceRange(clearanceRange);
     }
 
-    std::queue<glm::ivec2> coordQueue;
-    coordQueue.push(startDeg);
-    markSearchMap(startDeg, 0);
+    auto clearancePenalty = costMap.getClearancePenalty();
+    if (ImGui::SliderFloat("Clearance penalty", &clearancePenalty, 0.0f, 16.0f))
+    {
+        costMap.setClearancePenalty(clearancePenalty);
+    }
+}
 
-    const int dirx[] = {-1, 0, +1, 0};
-    const int diry[] = {0, -1, 0, +1};
+void KinematicChainApplication::showReachability()
+{
+    ImGui::Checkbox("Show reachability", &_reachabilityEnabled);
+    if (!_reachabilityEnabled)
+    {
+        return;
+    }
 
-    bool found = false;
-    int maxDist = 0;
-    while (!coordQueue.empty())
+    // The map belongs to the job while it runs; a map that went stale
+    // meanwhile is built again once the job is done. Cancelling turns the
+    // overlay off rather than starting over.
+    if (_reachabilityJob->isRunning())
     {
-        auto current = coordQueue.front();
-        coordQueue.pop();
+        showJobProgress(*_reachabilityJob, "Cancel##reachability");
+        _reachabilityEnabled = !_reachabilityJob->isCancelled();
+    }
+    else
+    {
+        auto area = getVisibleArea();
+        auto size = area.max - area.min;
+        auto columns = ReachabilityMap::cDefaultColumns;
+        _reachabilityMap->setResolution(
+            columns,
+            std::max(1, static_cast<int>(columns * size.y / size.x))
+        );
 
-        if (current == endDeg)
+        _configurationSpace->setArmLengths(
+            _armController->getFirstArmLength(),
+            _armController->getSecondArmLength()
+        );
+
+        if (!_reachabilityMap->isValid(*_configurationSpace, area))
         {
-            found = true;
-            break;
+            createReachabilityMap(area);
         }
+    }
 
-        int nextDist = getSearchMapValue(current) + 1;
-        maxDist = std::max(maxDist, nextDist);
+    if (_reachabilityTexture == 0)
+    {
+        return;
+    }
 
-        for (auto i = 0; i < 4; ++i)
-        {
-            glm::ivec2 next{
-                (current.x + dirx[i]) % 360,
-                (current.y + diry[i]) % 360
-            };
+    ImGui::Text("Free inverse kinematics solutions over the view:");
+    ImGui::TextColored({1.0f, 0.6f, 0.0f, 1.0f}, "one");
+    ImGui::SameLine();
+    ImGui::TextColored({1.0f, 1.0f, 0.0f, 1.0f}, "two, apart");
+    ImGui::SameLine();
+    ImGui::TextColored({0.0f, 0.8f, 0.0f, 1.0f}, "two, connected");
 
-            if (next.x < 0) { next.x += 360; }
-            if (next.y < 0) { next.y += 360; }
+    auto scale = ImGui::GetContentRegionAvailWidth()
+        / _reachabilityMap->getColumns();
+    ImGui::Image(
+        (void*)_reachabilityTexture,
+        ImVec2(
+            _reachabilityMap->getColumns() * scale,
+            _reachabilityMap->getRows() * scale
+        )
+    );
+}
 
-            if (!verifyAvailability(next)) { continue; }
+void KinematicChainApplication::createReachabilityMap(
+    const fw::AABB<glm::vec2>& area
+)
+{
+    // Built on a copy so that obstacles can be edited meanwhile; the map
+    // is valid for the space as long as the copy still matches it.
+    auto space = std::make_shared<ConfigurationSpace>(*_configurationSpace);
+    space->setThreadPool(_jobThreadPool);
+    auto map = _reachabilityMap;
+
+    _reachabilityJob->start(
+        [space, map, area](JobProgress& progress)
+        {
+            return map->create(*space, area, &progress);
+        },
+        [this]()
+        {
+            createReachabilityTexture();
+        }
+    );
+}
 
-            auto nextCurrentValue = getSearchMapValue(next);
+void KinematicChainApplication::createReachabilityTexture()
+{
+    auto columns = _reachabilityMap->getColumns();
+    auto rows = _reachabilityMap->getRows();
 
-            if (nextCurrentValue > nextDist)
+    // Texture rows go top down, the map's bottom up.
+    std::vector<unsigned char> image;
+    image.reserve(3 * columns * rows);
+    for (auto row = rows - 1; row >= 0; --row)
+    {
+        for (auto column = 0; column < columns; ++column)
+        {
+            glm::ivec3 color{40, 40, 40};
+            if (_reachabilityMap->areSolutionsConnected(column, row))
             {
-                auto index = 360 * next.x + next.y;
-                _searchMapTraceback[index] = current;
-                markSearchMap(next, nextDist);
-                coordQueue.push(next);
+                color = {0, 204, 0};
             }
+            else if (_reachabilityMap->getSolutionCount(column, row) == 2)
+            {
+                color = {255, 255, 0};
+            }
+            else if (_reachabilityMap->getSolutionCount(column, row) == 1)
+            {
+                color = {255, 153, 0};
+            }
+
+            image.push_back(static_cast<unsigned char>(color.x));
+            image.push_back(static_cast<unsigned char>(color.y));
+            image.push_back(static_cast<unsigned char>(color.z));
         }
     }
 
-    _configurationPath.clear();
-
-    if (found)
+    if (_reachabilityTexture == 0)
     {
-        trackbackAndStorePath(endDeg);
-        _animationEnabled = false;
-        _currentAnimationStep = 0;
-        _frameAnimationPassed = 0.0f;
+        glGenTextures(1, &_reachabilityTexture);
     }
 
-    for (auto &pathStep: _configurationPath)
+    glBindTexture(GL_TEXTURE_2D, _reachabilityTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, columns, rows, 0,
+        GL_RGB, GL_UNSIGNED_BYTE, image.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void KinematicChainApplication::findPath()
+{
+    takePlanningSnapshot();
+    resetPaths();
+    _searchMapAvailable = false;
+
+    auto space = _planningSpace;
+    auto chainSpace = _planningChainSpace;
+    auto planner = _pathPlanner;
+    auto smoother = getActiveSmoother();
+    auto step = getDisplayStep();
+    auto startDeg = space->getClosestInConfiguration(_startConfiguration);
+    auto endDeg = space->getClosestInConfiguration(_endConfiguration);
+    auto path = std::make_shared<std::vector<JointVector>>();
+
+    _planningJob->start(
+        [=](JobProgress& progress)
+        {
+            if (planner->findPath(*space, startDeg, endDeg))
+            {
+                progress.setProgress(0.5f);
+                *path = refineMotionPath(
+                    smoother.get(),
+                    *chainSpace,
+                    getCellPath(*space, planner->getPath()),
+                    step
+                );
+            }
+
+            progress.setProgress(1.0f);
+            return true;
+        },
+        [this, planner, path, startDeg, endDeg]()
+        {
+            if (!path->empty())
+            {
+                _configurationPath = planner->getPath();
+                storeMotionPath(*path);
+            }
+
+            createSearchMapTexture(startDeg, endDeg);
+        }
+    );
+}
+
+void KinematicChainApplication::goToEndConfiguration()
+{
+    takePlanningSnapshot();
+
+    auto current = _startConfiguration;
+    auto solutions = getValidSolutions();
+    if (solutions.size() > 0)
     {
-        markSearchMap(pathStep, -2);
+        current = glm::vec2{solutions[0].first, solutions[0].second};
     }
 
-    markSearchMap(startDeg, -1);
-    markSearchMap(endDeg, -1);
+    auto space = _planningSpace;
+    auto chainSpace = _planningChainSpace;
+    auto goalField = _goalField;
+    auto smoother = getActiveSmoother();
+    auto step = getDisplayStep();
+    auto startDeg = space->getClosestInConfiguration(current);
+    auto endDeg = space->getClosestInConfiguration(_endConfiguration);
+    auto cells = std::make_shared<std::vector<glm::ivec2>>();
+    auto path = std::make_shared<std::vector<JointVector>>();
+
+    _planningJob->start(
+        [=](JobProgress& progress)
+        {
+            if (!goalField->isValid(*space, endDeg))
+            {
+                goalField->create(*space, endDeg);
+            }
+
+            progress.setProgress(0.5f);
+            if (!goalField->descend(startDeg, *cells))
+            {
+                return false;
+            }
+
+            *path = refineMotionPath(
+                smoother.get(),
+                *chainSpace,
+                getCellPath(*space, *cells),
+                step
+            );
+
+            progress.setProgress(1.0f);
+            return true;
+        },
+        [this, cells, path]()
+        {
+            _configurationPath = *cells;
+            storeMotionPath(*path);
+            _animationTime = 0.0f;
+            _animationEnabled = _chainPath.size() > 1;
+        }
+    );
+}
+
+void KinematicChainApplication::createSearchMapTexture(
+    glm::ivec2 start,
+    glm::ivec2 end
+)
+{
+    auto maxDist = _pathPlanner->getMaxDistance();
+    auto resolution = _configurationSpace->getResolution();
 
     std::vector<unsigned char> image;
-    for (const auto& state: _searchMap)
+    for (auto i = 0; i < resolution * resolution; ++i)
     {
-        if (state == cSearchMapMax)
+        auto state = _pathPlanner->getSearchMapState(
+            {i / resolution, i % resolution}
+        );
+
+        if (state == PathPlanner::cSearchMapUnvisited)
         {
             image.push_back(0);
             image.push_back(0);
@@ -794,22 +1185,6 @@ void KinematicChainApplication::findPath()
             continue;
         }
 
-        if (state == -1)
-        {
-            image.push_back(255);
-            image.push_back(0);
-            image.push_back(255);
-            continue;
-        }
-
-        if (state == -2)
-        {
-            image.push_back(255);
-            image.push_back(255);
-            image.push_back(255);
-            continue;
-        }
-
         auto gradient = std::min(1.0f, static_cast<float>(state) / maxDist);
         int hue = static_cast<int>(260 * gradient);
         auto color = glm::rgbColor(glm::vec3{hue, 1.0f, 1.0f});
@@ -827,72 +1202,279 @@ void KinematicChainApplication::findPath()
         );
     }
 
+    auto paint = [&](glm::ivec2 coord, glm::ivec3 color)
+    {
+        auto index = 3 * (resolution * coord.x + coord.y);
+        image[index + 0] = static_cast<unsigned char>(color.x);
+        image[index + 1] = static_cast<unsigned char>(color.y);
+        image[index + 2] = static_cast<unsigned char>(color.z);
+    };
+
+    for (const auto& angles: _chainPath)
+    {
+        paint(
+            _configurationSpace->getClosestInConfiguration(
+                {angles[0], angles[1]}
+            ),
+            {255, 255, 255}
+        );
+    }
+
+    paint(start, {255, 0, 255});
+    paint(end, {255, 0, 255});
+
     _searchMapAvailable = true;
-    glGenTextures(1, &_searchMapTexture);
+    if (_searchMapTexture == 0)
+    {
+        glGenTextures(1, &_searchMapTexture);
+    }
+
     glBindTexture(GL_TEXTURE_2D, _searchMapTexture);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 360, 360, 0,
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, resolution, resolution, 0,
         GL_RGB, GL_UNSIGNED_BYTE, image.data());
     glBindTexture(GL_TEXTURE_2D, 0);
 }
 
-void KinematicChainApplication::markSearchMap(glm::ivec2 coord, int value)
+void KinematicChainApplication::updatePolygonalLine()
 {
-    auto index = 360 * coord.x + coord.y;
-    _searchMap[index] = value;
+    std::vector<fw::VertexColor> vertices;
+
+    auto chain = _armController->getChain();
+    std::vector<glm::vec2> positions(_jointCount + 1);
+
+    for (const auto& angles: _chainPath)
+    {
+        chain.computeJointPositions(angles.data(), positions.data());
+        vertices.push_back({
+            {positions.back(), 0.0f},
+            {1.0f, 1.0f, 1.0f}
+        });
+    }
+
+    _line = std::make_shared<fw::PolygonalLine>(vertices);
 }
 
-int KinematicChainApplication::getSearchMapValue(glm::ivec2 coord)
+void KinematicChainApplication::updatePathGhosts()
 {
-    auto index = 360 * coord.x + coord.y;
-    return _searchMap[index];
+    // Every pose along the path, fading in towards its end.
+    _ghostBatch->clear();
+    _armRendering->setChain(_armController->getChain());
+    _armRendering->setArmsThickness(_armController->getVisualThickness());
+    _armRendering->renderPath(
+        *_ghostBatch,
+        _chainPath,
+        {0.3f, 1.0f, 1.0f, 0.05f},
+        {0.3f, 1.0f, 1.0f, 0.35f}
+    );
 }
 
-bool KinematicChainApplication::verifyAvailability(glm::ivec2 coord)
+void KinematicChainApplication::syncChainSpace()
 {
-    auto index = 360 * coord.x + coord.y;
-    return _availabilityMap[index];
+    _chainSpace->setChain(_armController->getChain());
+    _chainSpace->setObstacles(_configurationSpace);
 }
 
-void KinematicChainApplication::trackbackAndStorePath(glm::ivec2 end)
+void KinematicChainApplication::createChainPlanner()
 {
-    std::vector<glm::ivec2> newPath;
-    auto current = end;
-    while (current != glm::ivec2{-1, -1})
+    switch (_chainPlannerKind)
     {
-        newPath.push_back(current);
-        auto index = 360 * current.x + current.y;
-        current = _searchMapTraceback[index];
+    case 1:
+        _chainPlanner = std::make_shared<LazyPRMPlanner>();
+        break;
+    case 2:
+        _chainPlanner = std::make_shared<LatticePlanner>();
+        break;
+    default:
+        _chainPlanner = std::make_shared<RRTConnectPlanner>();
+        break;
     }
 
-    _configurationPath.clear();
-    std::reverse_copy(
-        std::begin(newPath),
-        std::end(newPath),
-        std::back_inserter(_configurationPath)
+    _chainPathFailed = false;
+}
+
+void KinematicChainApplication::showChainPathFinding()
+{
+    if (ImGui::Button("Store current as start"))
+    {
+        _chainStart = _armController->getJointAngles();
+    }
+
+    ImGui::SameLine();
+    if (ImGui::Button("Store current as end"))
+    {
+        _chainEnd = _armController->getJointAngles();
+    }
+
+    if (_planningJob->isRunning())
+    {
+        showJobProgress(*_planningJob, "Cancel##chain");
+        return;
+    }
+
+    const char* plannerNames[] = {
+        "RRT-Connect",
+        "Lazy roadmap",
+        "Lattice A*"
+    };
+
+    if (ImGui::Combo("Planner##chain", &_chainPlannerKind, plannerNames, 3))
+    {
+        createChainPlanner();
+    }
+
+    ImGui::Checkbox("Smooth path##chain", &_pathSmoothingEnabled);
+
+    if (ImGui::Button("Find path##chain"))
+    {
+        findChainPath();
+    }
+
+    if (_chainPath.size() > 0)
+    {
+        ImGui::Text(
+            "Path of %d configurations, expanded nodes: %d",
+            static_cast<int>(_chainPath.size()),
+            _chainPlanner->getExpandedNodes()
+        );
+    }
+    else if (_chainPathFailed)
+    {
+        ImGui::TextColored({1.0f, 0.0f, 0.0f, 1.0f}, "Path not found.");
+    }
+}
+
+void KinematicChainApplication::findChainPath()
+{
+    takePlanningSnapshot();
+    resetPaths();
+
+    auto chainSpace = _planningChainSpace;
+    auto planner = _chainPlanner;
+    auto smoother = getActiveSmoother();
+    auto step = getDisplayStep();
+    auto start = _chainStart;
+    auto end = _chainEnd;
+    auto path = std::make_shared<std::vector<JointVector>>();
+
+    _planningJob->start(
+        [=](JobProgress& progress)
+        {
+            if (planner->findPath(*chainSpace, start, end))
+            {
+                progress.setProgress(0.5f);
+                *path = refineMotionPath(
+                    smoother.get(),
+                    *chainSpace,
+                    planner->getPath(),
+                    step
+                );
+            }
+
+            progress.setProgress(1.0f);
+            return true;
+        },
+        [this, path]()
+        {
+            if (path->empty())
+            {
+                _chainPathFailed = true;
+                return;
+            }
+
+            storeMotionPath(*path);
+        }
     );
+}
+
+void KinematicChainApplication::takePlanningSnapshot()
+{
+    // Planning jobs work on a copy, so obstacles can be edited meanwhile.
+    // A job still winding down may be reading the current copy, so changes
+    // go into new ones. Unchanged copies are kept, and planners that cache
+    // work per space still find them.
+    auto spaceChanged =
+        _planningSpace->getRevision() != _configurationSpace->getRevision();
+    if (spaceChanged)
+    {
+        _planningSpace =
+            std::make_shared<ConfigurationSpace>(*_configurationSpace);
+        _planningSpace->setThreadPool(_jobThreadPool);
+    }
+
+    auto chain = _armController->getChain();
+    if (spaceChanged || chain.getLinkLengths()
+        != _planningChainSpace->getChain().getLinkLengths())
+    {
+        _planningChainSpace = std::make_shared<ChainConfigurationSpace>();
+        _planningChainSpace->setChain(chain);
+        _planningChainSpace->setObstacles(_planningSpace);
+    }
+}
 
+std::shared_ptr<PathSmoother>
+    KinematicChainApplication::getActiveSmoother() const
+{
+    return _pathSmoothingEnabled ? _pathSmoother : nullptr;
+}
+
+void KinematicChainApplication::storeMotionPath(
+    std::vector<JointVector> path
+)
+{
+    _chainPath = std::move(path);
     updatePolygonalLine();
+    updatePathGhosts();
+    createTrajectory();
 }
 
-void KinematicChainApplication::updatePolygonalLine()
+void KinematicChainApplication::createTrajectory()
 {
-    std::vector<fw::VertexColor> vertices;
-    for (const auto& pos: _configurationPath)
-    {
-        auto config = _armController->buildConfiguration(
-            glm::radians(static_cast<float>(pos.x)),
-            glm::radians(static_cast<float>(pos.y))
-        );
+    _trajectory->setVelocityLimits(
+        JointVector(_jointCount, _jointVelocityLimit)
+    );
+    _trajectory->setAccelerationLimits(
+        JointVector(_jointCount, _jointAccelerationLimit)
+    );
+    _trajectory->create(_chainPath);
 
-        vertices.push_back({
-            {config.second, 0.0f},
-            {1.0f, 1.0f, 1.0f}
-        });
+    _animationTime = std::min(_animationTime, _trajectory->getDuration());
+}
+
+float KinematicChainApplication::getDisplayStep() const
+{
+    // Stored paths are split finely enough to draw: one map cell for two
+    // joints, one lattice step for longer chains.
+    auto resolution = _jointCount == 2
+        ? _configurationSpace->getResolution()
+        : LatticePlanner::cDefaultResolution;
+
+    return glm::two_pi<float>() / resolution;
+}
+
+JointVector KinematicChainApplication::getChainPose() const
+{
+    if (!_animationEnabled || _trajectory->isEmpty())
+    {
+        return _armController->getJointAngles();
     }
 
-    _line = std::make_shared<fw::PolygonalLine>(vertices);
+    JointVector pose;
+    _trajectory->sample(_animationTime, pose);
+    return pose;
+}
+
+void KinematicChainApplication::resetPaths()
+{
+    _configurationPath.clear();
+    _chainPath.clear();
+    _chainPathFailed = false;
+    _line = nullptr;
+    _ghostBatch->clear();
+    _trajectory->clear();
+    _animationEnabled = false;
+    _animationTime = 0.0f;
 }
 
 }
@@ -0,0 +1,321 @@
+#include "LatticePlanner.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+
+#include "glm/gtc/constants.hpp"
+
+namespace kinematic
+{
+
+namespace
+{
+    struct OpenNode
+    {
+        int estimate;
+        int heuristic;
+        std::uint64_t key;
+
+        bool operator>(const OpenNode& other) const
+        {
+            if (estimate != other.estimate)
+            {
+                return estimate > other.estimate;
+            }
+
+            return heuristic > other.heuristic;
+        }
+    };
+
+    struct NodeRecord
+    {
+        int cost;
+        std::uint64_t parent;
+        bool blocked;
+        bool closed;
+        // Blocked moves to the next step of each joint, one bit per joint.
+        std::uint64_t blockedMoves;
+    };
+
+    const int cUnreached = std::numeric_limits<int>::max();
+}
+
+const int LatticePlanner::cDefaultResolution = 72;
+const int LatticePlanner::cDefaultExpansionLimit = 500000;
+const float LatticePlanner::cDefaultCollisionStep = 0.01f;
+
+LatticePlanner::LatticePlanner():
+    _resolution{cDefaultResolution},
+    _expansionLimit{cDefaultExpansionLimit},
+    _collisionStep{cDefaultCollisionStep},
+    _bitsPerJoint{0}
+{
+}
+
+LatticePlanner::~LatticePlanner()
+{
+}
+
+void LatticePlanner::setResolution(int resolution)
+{
+    _resolution = resolution;
+}
+
+int LatticePlanner::getResolution() const
+{
+    return _resolution;
+}
+
+void LatticePlanner::setExpansionLimit(int expansionLimit)
+{
+    _expansionLimit = expansionLimit;
+}
+
+int LatticePlanner::getExpansionLimit() const
+{
+    return _expansionLimit;
+}
+
+void LatticePlanner::setCollisionStep(float collisionStep)
+{
+    _collisionStep = collisionStep;
+}
+
+float LatticePlanner::getCollisionStep() const
+{
+    return _collisionStep;
+}
+
+bool LatticePlanner::findPath(
+    const ChainConfigurationSpace& space,
+    const JointVector& start,
+    const JointVector& goal
+)
+{
+    resetSearch();
+
+    auto dimension = space.getDimension();
+
+    _bitsPerJoint = 1;
+    while ((1 << _bitsPerJoint) < _resolution) { ++_bitsPerJoint; }
+
+    if (dimension == 0 || dimension * _bitsPerJoint > 64)
+    {
+        return false;
+    }
+
+    std::vector<int> startSteps(dimension), goalSteps(dimension);
+    for (auto joint = 0; joint < dimension; ++joint)
+    {
+        startSteps[joint] = snap(start[joint]);
+        goalSteps[joint] = snap(goal[joint]);
+    }
+
+    JointVector angles(dimension), nextAngles(dimension);
+
+    getAngles(startSteps, angles);
+    getAngles(goalSteps, nextAngles);
+    if (!space.checkMotion(start.data(), angles.data(), _collisionStep)
+        || !space.checkMotion(nextAngles.data(), goal.data(), _collisionStep))
+    {
+        return false;
+    }
+
+    auto startKey = encode(startSteps);
+    auto goalKey = encode(goalSteps);
+
+    std::unordered_map<std::uint64_t, NodeRecord> nodes;
+    std::priority_queue<
+        OpenNode,
+        std::vector<OpenNode>,
+        std::greater<OpenNode>
+    > openSet;
+
+    auto startHeuristic = getHeuristic(startSteps, goalSteps);
+    nodes[startKey] = {0, startKey, false, false, 0};
+    openSet.push({startHeuristic, startHeuristic, startKey});
+
+    std::vector<int> steps(dimension), next(dimension);
+    bool found = false;
+
+    while (!openSet.empty() && _expandedNodes < _expansionLimit)
+    {
+        auto top = openSet.top();
+        openSet.pop();
+
+        auto& record = nodes[top.key];
+        if (record.closed)
+        {
+            continue;
+        }
+
+        record.closed = true;
+
+        if (top.key == goalKey)
+        {
+            found = true;
+            break;
+        }
+
+        ++_expandedNodes;
+        auto cost = record.cost;
+        decode(top.key, steps);
+        getAngles(steps, angles);
+
+        for (auto joint = 0; joint < dimension; ++joint)
+        {
+            for (auto direction = -1; direction <= 1; direction += 2)
+            {
+                next = steps;
+                next[joint] = (steps[joint] + direction + _resolution)
+                    % _resolution;
+                auto nextKey = encode(next);
+                getAngles(next, nextAngles);
+
+                auto it = nodes.find(nextKey);
+                if (it == std::end(nodes))
+                {
+                    auto blocked = !space.checkConfiguration(nextAngles);
+                    it = nodes.insert({
+                        nextKey,
+                        {cUnreached, 0, blocked, false, 0}
+                    }).first;
+                }
+
+                auto& nextRecord = it->second;
+                if (nextRecord.blocked
+                    || nextRecord.closed
+                    || nextRecord.cost <= cost + 1)
+                {
+                    continue;
+                }
+
+                // A move is recorded at the lattice point it leaves towards
+                // the next step, whichever way the search crosses it.
+                auto& owner = direction > 0 ? record : nextRecord;
+                auto bit = std::uint64_t{1} << joint;
+                if ((owner.blockedMoves & bit) != 0)
+                {
+                    continue;
+                }
+
+                if (!space.checkMotion(
+                    angles.data(),
+                    nextAngles.data(),
+                    _collisionStep))
+                {
+                    owner.blockedMoves |= bit;
+                    continue;
+                }
+
+                nextRecord.cost = cost + 1;
+                nextRecord.parent = top.key;
+
+                auto heuristic = getHeuristic(next, goalSteps);
+                openSet.push({cost + 1 + heuristic, heuristic, nextKey});
+            }
+        }
+    }
+
+    if (!found)
+    {
+        return false;
+    }
+
+    for (auto key = goalKey; ; key = nodes[key].parent)
+    {
+        decode(key, steps);
+        getAngles(steps, angles);
+        _path.push_back(angles);
+
+        if (key == startKey)
+        {
+            break;
+        }
+    }
+
+    std::reverse(std::begin(_path), std::end(_path));
+
+    for (auto joint = 0; joint < dimension; ++joint)
+    {
+        angles[joint] = ChainConfigurationSpace::wrapAngle(start[joint]);
+        nextAngles[joint] = ChainConfigurationSpace::wrapAngle(goal[joint]);
+    }
+
+    if (angles != _path.front())
+    {
+        _path.insert(std::begin(_path), angles);
+    }
+
+    if (nextAngles != _path.back())
+    {
+        _path.push_back(nextAngles);
+    }
+
+    return true;
+}
+
+std::uint64_t LatticePlanner::encode(const std::vector<int>& steps) const
+{
+    std::uint64_t key = 0;
+    for (auto step: steps)
+    {
+        key = (key << _bitsPerJoint) | static_cast<std::uint64_t>(step);
+    }
+
+    return key;
+}
+
+void LatticePlanner::decode(std::uint64_t key, std::vector<int>& steps) const
+{
+    auto mask = (std::uint64_t{1} << _bitsPerJoint) - 1;
+    for (auto joint = static_cast<int>(steps.size()) - 1; joint >= 0; --joint)
+    {
+        steps[joint] = static_cast<int>(key & mask);
+        key >>= _bitsPerJoint;
+    }
+}
+
+int LatticePlanner::snap(float angle) const
+{
+    auto step = static_cast<int>(std::round(
+        ChainConfigurationSpace::wrapAngle(angle) * _resolution
+            / glm::two_pi<float>()
+    ));
+
+    return step % _resolution;
+}
+
+void LatticePlanner::getAngles(
+    const std::vector<int>& steps,
+    JointVector& angles
+) const
+{
+    auto cellAngle = glm::two_pi<float>() / _resolution;
+    for (auto joint = 0; joint < static_cast<int>(steps.size()); ++joint)
+    {
+        angles[joint] = steps[joint] * cellAngle;
+    }
+}
+
+int LatticePlanner::getHeuristic(
+    const std::vector<int>& steps,
+    const std::vector<int>& goal
+) const
+{
+    int distance = 0;
+    for (auto joint = 0; joint < static_cast<int>(steps.size()); ++joint)
+    {
+        auto delta = std::abs(steps[joint] - goal[joint]);
+        distance += std::min(delta, _resolution - delta);
+    }
+
+    return distance;
+}
+
+}
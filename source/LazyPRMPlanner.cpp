@@ -0,0 +1,444 @@
+#include "LazyPRMPlanner.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <random>
+
+#include "glm/gtc/constants.hpp"
+
+namespace kinematic
+{
+
+namespace
+{
+    const signed char cNodeUnknown = 0;
+    const signed char cNodeFree = 1;
+    const signed char cNodeBlocked = -1;
+
+    struct OpenNode
+    {
+        float estimate;
+        int node;
+
+        bool operator>(const OpenNode& other) const
+        {
+            return estimate > other.estimate;
+        }
+    };
+}
+
+const unsigned LazyPRMPlanner::cDefaultSeed = 5489u;
+const int LazyPRMPlanner::cDefaultSampleCount = 2000;
+const int LazyPRMPlanner::cDefaultNeighbourCount = 10;
+const float LazyPRMPlanner::cDefaultCollisionStep = 0.01f;
+const int LazyPRMPlanner::cDefaultSearchLimit = 100;
+
+LazyPRMPlanner::LazyPRMPlanner():
+    _seed{cDefaultSeed},
+    _sampleCount{cDefaultSampleCount},
+    _neighbourCount{cDefaultNeighbourCount},
+    _collisionStep{cDefaultCollisionStep},
+    _searchLimit{cDefaultSearchLimit},
+    _roadmapValid{false},
+    _space{nullptr},
+    _spaceRevision{0}
+{
+}
+
+LazyPRMPlanner::~LazyPRMPlanner()
+{
+}
+
+void LazyPRMPlanner::setSeed(unsigned seed)
+{
+    _roadmapValid &= seed == _seed;
+    _seed = seed;
+}
+
+unsigned LazyPRMPlanner::getSeed() const
+{
+    return _seed;
+}
+
+void LazyPRMPlanner::setSampleCount(int sampleCount)
+{
+    _roadmapValid &= sampleCount == _sampleCount;
+    _sampleCount = sampleCount;
+}
+
+int LazyPRMPlanner::getSampleCount() const
+{
+    return _sampleCount;
+}
+
+void LazyPRMPlanner::setNeighbourCount(int neighbourCount)
+{
+    _roadmapValid &= neighbourCount == _neighbourCount;
+    _neighbourCount = neighbourCount;
+}
+
+int LazyPRMPlanner::getNeighbourCount() const
+{
+    return _neighbourCount;
+}
+
+void LazyPRMPlanner::setCollisionStep(float collisionStep)
+{
+    // Node results do not depend on the step, edge results do.
+    if (collisionStep != _collisionStep)
+    {
+        _edgeStates.clear();
+    }
+
+    _collisionStep = collisionStep;
+}
+
+float LazyPRMPlanner::getCollisionStep() const
+{
+    return _collisionStep;
+}
+
+void LazyPRMPlanner::setSearchLimit(int searchLimit)
+{
+    _searchLimit = searchLimit;
+}
+
+int LazyPRMPlanner::getSearchLimit() const
+{
+    return _searchLimit;
+}
+
+bool LazyPRMPlanner::findPath(
+    const ChainConfigurationSpace& space,
+    const JointVector& start,
+    const JointVector& goal
+)
+{
+    resetSearch();
+
+    auto dimension = space.getDimension();
+    if (!_roadmapValid || _roadmap.getDimension() != dimension)
+    {
+        buildRoadmap(dimension);
+    }
+
+    if (&space != _space || space.getRevision() != _spaceRevision)
+    {
+        _space = &space;
+        _spaceRevision = space.getRevision();
+        resetCollisionStates();
+    }
+
+    connectQuery(start, goal);
+
+    _nodeStates[_sampleCount] = space.checkConfiguration(start)
+        ? cNodeFree
+        : cNodeBlocked;
+    _nodeStates[_sampleCount + 1] = space.checkConfiguration(goal)
+        ? cNodeFree
+        : cNodeBlocked;
+
+    if (_nodeStates[_sampleCount] == cNodeBlocked
+        || _nodeStates[_sampleCount + 1] == cNodeBlocked)
+    {
+        return false;
+    }
+
+    std::vector<int> nodes;
+    for (auto search = 0;
+        search < _searchLimit && searchRoadmap(space, nodes);
+        ++search)
+    {
+        if (!validatePath(space, nodes))
+        {
+            continue;
+        }
+
+        for (auto node: nodes)
+        {
+            auto point = getPoint(node);
+            _path.emplace_back(point, point + dimension);
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+void LazyPRMPlanner::buildRoadmap(int dimension)
+{
+    std::mt19937 generator{_seed};
+    std::uniform_real_distribution<float> angle{0.0f, glm::two_pi<float>()};
+
+    _roadmap.reset(dimension);
+    JointVector sample(dimension);
+    for (auto i = 0; i < _sampleCount; ++i)
+    {
+        for (auto& value: sample)
+        {
+            value = angle(generator);
+        }
+
+        _roadmap.insert(sample.data());
+    }
+
+    _adjacency.assign(_sampleCount, {});
+    std::vector<int> neighbours;
+    for (auto i = 0; i < _sampleCount; ++i)
+    {
+        _roadmap.findNearest(
+            _roadmap.getPoint(i),
+            _neighbourCount + 1,
+            neighbours
+        );
+        for (auto neighbour: neighbours)
+        {
+            if (neighbour == i) { continue; }
+            _adjacency[i].push_back(neighbour);
+            _adjacency[neighbour].push_back(i);
+        }
+    }
+
+    for (auto& edges: _adjacency)
+    {
+        std::sort(std::begin(edges), std::end(edges));
+        auto last = std::unique(std::begin(edges), std::end(edges));
+        edges.erase(last, std::end(edges));
+    }
+
+    _roadmapValid = true;
+    resetCollisionStates();
+}
+
+void LazyPRMPlanner::resetCollisionStates()
+{
+    _nodeStates.assign(_sampleCount + 2, cNodeUnknown);
+    _edgeStates.clear();
+}
+
+void LazyPRMPlanner::connectQuery(
+    const JointVector& start,
+    const JointVector& goal
+)
+{
+    auto dimension = _roadmap.getDimension();
+    auto startNode = _sampleCount, goalNode = _sampleCount + 1;
+
+    _queryPoints.resize(2 * dimension);
+    for (auto joint = 0; joint < dimension; ++joint)
+    {
+        _queryPoints[joint] = ChainConfigurationSpace::wrapAngle(start[joint]);
+        _queryPoints[dimension + joint] =
+            ChainConfigurationSpace::wrapAngle(goal[joint]);
+    }
+
+    // The direct move is tried like any other edge.
+    _queryAdjacency.resize(2);
+    _queryAdjacency[0].assign(1, goalNode);
+    _queryAdjacency[1].assign(1, startNode);
+
+    std::vector<int> neighbours;
+    for (auto node: {startNode, goalNode})
+    {
+        _roadmap.findNearest(getPoint(node), _neighbourCount, neighbours);
+        auto& edges = _queryAdjacency[node - _sampleCount];
+        edges.insert(
+            std::end(edges),
+            std::begin(neighbours),
+            std::end(neighbours)
+        );
+    }
+
+    _queryEdgeStates.clear();
+}
+
+const float* LazyPRMPlanner::getPoint(int node) const
+{
+    if (node < _sampleCount)
+    {
+        return _roadmap.getPoint(node);
+    }
+
+    return &_queryPoints[(node - _sampleCount) * _roadmap.getDimension()];
+}
+
+void LazyPRMPlanner::getNeighbours(
+    int node,
+    std::vector<int>& neighbours
+) const
+{
+    if (node >= _sampleCount)
+    {
+        neighbours = _queryAdjacency[node - _sampleCount];
+        return;
+    }
+
+    neighbours = _adjacency[node];
+    for (auto query = 0; query < 2; ++query)
+    {
+        const auto& edges = _queryAdjacency[query];
+        if (std::find(std::begin(edges), std::end(edges), node)
+            != std::end(edges))
+        {
+            neighbours.push_back(_sampleCount + query);
+        }
+    }
+}
+
+bool LazyPRMPlanner::searchRoadmap(
+    const ChainConfigurationSpace& space,
+    std::vector<int>& nodes
+)
+{
+    auto dimension = _roadmap.getDimension();
+    auto startNode = _sampleCount, goalNode = _sampleCount + 1;
+    auto nodeCount = _sampleCount + 2;
+
+    auto distance = [&](int from, int to)
+    {
+        auto a = getPoint(from), b = getPoint(to);
+        float sum = 0.0f;
+        for (auto joint = 0; joint < dimension; ++joint)
+        {
+            sum += std::abs(
+                ChainConfigurationSpace::getAngleDifference(a[joint], b[joint])
+            );
+        }
+
+        return sum;
+    };
+
+    const float cUnvisited = -1.0f;
+    std::vector<float> costs(nodeCount, cUnvisited);
+    std::vector<int> parents(nodeCount, -1);
+    std::vector<bool> closed(nodeCount, false);
+
+    std::priority_queue<
+        OpenNode,
+        std::vector<OpenNode>,
+        std::greater<OpenNode>
+    > openSet;
+
+    costs[startNode] = 0.0f;
+    openSet.push({distance(startNode, goalNode), startNode});
+
+    while (!openSet.empty())
+    {
+        auto node = openSet.top().node;
+        openSet.pop();
+
+        if (closed[node]) { continue; }
+        closed[node] = true;
+
+        if (node == goalNode)
+        {
+            nodes.clear();
+            for (; node >= 0; node = parents[node])
+            {
+                nodes.push_back(node);
+            }
+
+            std::reverse(std::begin(nodes), std::end(nodes));
+            return true;
+        }
+
+        ++_expandedNodes;
+
+        getNeighbours(node, _neighbours);
+        for (auto next: _neighbours)
+        {
+            if (closed[next] || _nodeStates[next] == cNodeBlocked)
+            {
+                continue;
+            }
+
+            // Nodes are cheap next to edges, so they are checked as soon as
+            // the search reaches them.
+            if (_nodeStates[next] == cNodeUnknown)
+            {
+                _nodeStates[next] = space.checkConfiguration(getPoint(next))
+                    ? cNodeFree
+                    : cNodeBlocked;
+
+                if (_nodeStates[next] == cNodeBlocked)
+                {
+                    continue;
+                }
+            }
+
+            auto& edgeStates = getEdgeStates(node, next);
+            auto edge = edgeStates.find(getEdgeKey(node, next));
+            if (edge != std::end(edgeStates) && !edge->second)
+            {
+                continue;
+            }
+
+            auto cost = costs[node] + distance(node, next);
+            if (costs[next] != cUnvisited && costs[next] <= cost)
+            {
+                continue;
+            }
+
+            costs[next] = cost;
+            parents[next] = node;
+            openSet.push({cost + distance(next, goalNode), next});
+        }
+    }
+
+    return false;
+}
+
+bool LazyPRMPlanner::validatePath(
+    const ChainConfigurationSpace& space,
+    const std::vector<int>& nodes
+)
+{
+    // Every edge of the candidate is checked even after one fails, so the
+    // next search already knows about all of them.
+    bool valid = true;
+    for (auto i = 0; i + 1 < static_cast<int>(nodes.size()); ++i)
+    {
+        auto& edgeStates = getEdgeStates(nodes[i], nodes[i + 1]);
+        auto key = getEdgeKey(nodes[i], nodes[i + 1]);
+        auto edge = edgeStates.find(key);
+        if (edge == std::end(edgeStates))
+        {
+            auto free = space.checkMotion(
+                getPoint(nodes[i]),
+                getPoint(nodes[i + 1]),
+                _collisionStep
+            );
+            edge = edgeStates.insert({key, free}).first;
+        }
+
+        valid &= edge->second;
+    }
+
+    return valid;
+}
+
+std::uint64_t LazyPRMPlanner::getEdgeKey(int from, int to) const
+{
+    auto low = static_cast<std::uint32_t>(std::min(from, to));
+    auto high = static_cast<std::uint32_t>(std::max(from, to));
+    return (static_cast<std::uint64_t>(low) << 32) | high;
+}
+
+std::unordered_map<std::uint64_t, bool>& LazyPRMPlanner::getEdgeStates(
+    int from,
+    int to
+)
+{
+    // Edges touching the start or goal only exist for one query.
+    if (from >= _sampleCount || to >= _sampleCount)
+    {
+        return _queryEdgeStates;
+    }
+
+    return _edgeStates;
+}
+
+}
@@ -0,0 +1,73 @@
+#include "MultiQueryPlanner.hpp"
+
+namespace kinematic
+{
+
+MultiQueryPlanner::MultiQueryPlanner():
+    _space{nullptr},
+    _spaceRevision{0},
+    _goalFieldShown{false}
+{
+}
+
+MultiQueryPlanner::~MultiQueryPlanner()
+{
+}
+
+bool MultiQueryPlanner::findPath(
+    const ConfigurationSpace& space,
+    glm::ivec2 start,
+    glm::ivec2 end
+)
+{
+    resetSearch(space.getResolution());
+    updateComponents(space);
+
+    _goalFieldShown = _components.areConnected(start, end);
+    if (!_goalFieldShown)
+    {
+        return false;
+    }
+
+    if (!_goalField.isValid(space, end))
+    {
+        _goalField.create(space, end);
+        _expandedNodes = _goalField.getExpandedNodes();
+    }
+
+    _maxDistance = _goalField.getMaxDistance();
+    return _goalField.descend(start, _path);
+}
+
+int MultiQueryPlanner::getSearchMapState(glm::ivec2 coord) const
+{
+    if (!_goalFieldShown)
+    {
+        return cSearchMapUnvisited;
+    }
+
+    auto distance = _goalField.getDistance(coord);
+    return distance == DistanceField::cUnreachable
+        ? cSearchMapUnvisited
+        : distance;
+}
+
+const ConnectedComponents& MultiQueryPlanner::getComponents() const
+{
+    return _components;
+}
+
+void MultiQueryPlanner::updateComponents(const ConfigurationSpace& space)
+{
+    if (_space == &space && _spaceRevision == space.getRevision())
+    {
+        return;
+    }
+
+    _space = &space;
+    _spaceRevision = space.getRevision();
+
+    _components.build(space.getOccupancyGrid(), *space.getThreadPool());
+}
+
+}
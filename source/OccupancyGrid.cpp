@@ -0,0 +1,165 @@
+#include "OccupancyGrid.hpp"
+
+#include <algorithm>
+
+namespace kinematic
+{
+
+namespace
+{
+    const int cWordsPerCacheLine = OccupancyGrid::cCacheLineSize
+        / sizeof(std::uint64_t);
+
+    int popCount(std::uint64_t word)
+    {
+#if defined(__GNUC__)
+        return __builtin_popcountll(word);
+#else
+        auto count = 0;
+        for (; word != 0; word &= word - 1) { ++count; }
+        return count;
+#endif
+    }
+
+    std::uint64_t rangeMask(int first, int last)
+    {
+        auto upper = last >= OccupancyGrid::cBitsPerWord
+            ? ~std::uint64_t{0}
+            : (std::uint64_t{1} << last) - 1;
+        auto lower = (std::uint64_t{1} << first) - 1;
+        return upper & ~lower;
+    }
+}
+
+const int OccupancyGrid::cBitsPerWord;
+const int OccupancyGrid::cCacheLineSize;
+
+OccupancyGrid::OccupancyGrid():
+    _rows{0},
+    _columns{0},
+    _wordsPerRow{0}
+{
+}
+
+OccupancyGrid::OccupancyGrid(int rows, int columns):
+    OccupancyGrid{}
+{
+    resize(rows, columns);
+}
+
+OccupancyGrid::~OccupancyGrid()
+{
+}
+
+void OccupancyGrid::resize(int rows, int columns)
+{
+    _rows = rows;
+    _columns = columns;
+
+    auto words = (columns + cBitsPerWord - 1) / cBitsPerWord;
+    _wordsPerRow = (words + cWordsPerCacheLine - 1)
+        / cWordsPerCacheLine * cWordsPerCacheLine;
+
+    _words.assign(static_cast<size_t>(_rows) * _wordsPerRow, 0);
+    for (auto row = 0; row < _rows; ++row)
+    {
+        maskPadding(row);
+    }
+}
+
+int OccupancyGrid::getRows() const
+{
+    return _rows;
+}
+
+int OccupancyGrid::getColumns() const
+{
+    return _columns;
+}
+
+int OccupancyGrid::getWordsPerRow() const
+{
+    return _wordsPerRow;
+}
+
+bool OccupancyGrid::isOccupied(int row, int column) const
+{
+    auto word = getRow(row)[column / cBitsPerWord];
+    return (word >> (column % cBitsPerWord)) & 1;
+}
+
+void OccupancyGrid::setOccupied(int row, int column, bool occupied)
+{
+    auto& word = getRow(row)[column / cBitsPerWord];
+    auto bit = std::uint64_t{1} << (column % cBitsPerWord);
+    word = occupied ? (word | bit) : (word & ~bit);
+}
+
+void OccupancyGrid::setOccupied(
+    int row,
+    int firstColumn,
+    int lastColumn,
+    bool occupied
+)
+{
+    auto words = getRow(row);
+    for (auto column = firstColumn; column < lastColumn;)
+    {
+        auto wordIndex = column / cBitsPerWord;
+        auto first = column % cBitsPerWord;
+        auto last = std::min(
+            cBitsPerWord,
+            first + (lastColumn - column)
+        );
+
+        auto mask = rangeMask(first, last);
+        words[wordIndex] = occupied
+            ? (words[wordIndex] | mask)
+            : (words[wordIndex] & ~mask);
+
+        column += last - first;
+    }
+}
+
+void OccupancyGrid::fill(bool occupied)
+{
+    std::fill(
+        std::begin(_words),
+        std::end(_words),
+        occupied ? ~std::uint64_t{0} : std::uint64_t{0}
+    );
+
+    for (auto row = 0; row < _rows; ++row)
+    {
+        maskPadding(row);
+    }
+}
+
+int OccupancyGrid::countOccupied() const
+{
+    auto padding = _wordsPerRow * cBitsPerWord - _columns;
+    auto count = 0;
+    for (auto word: _words)
+    {
+        count += popCount(word);
+    }
+
+    return count - padding * _rows;
+}
+
+const std::uint64_t* OccupancyGrid::getRow(int row) const
+{
+    return &_words[static_cast<size_t>(row) * _wordsPerRow];
+}
+
+std::uint64_t* OccupancyGrid::getRow(int row)
+{
+    return &_words[static_cast<size_t>(row) * _wordsPerRow];
+}
+
+void OccupancyGrid::maskPadding(int row)
+{
+    setOccupied(row, _columns, _wordsPerRow * cBitsPerWord, true);
+}
+
+}
@@ -0,0 +1,167 @@
+#include "PathPlanner.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+
+namespace kinematic
+{
+
+const int PathPlanner::cSearchMapUnvisited = -1;
+
+PathPlanner::PathPlanner():
+    _searchMapRecording{true},
+    _resolution{0},
+    _maxDistance{0},
+    _expandedNodes{0},
+    _searchGeneration{0}
+{
+}
+
+PathPlanner::~PathPlanner()
+{
+}
+
+void PathPlanner::setSearchMapRecording(bool enabled)
+{
+    _searchMapRecording = enabled;
+}
+
+bool PathPlanner::isSearchMapRecording() const
+{
+    return _searchMapRecording;
+}
+
+const std::vector<glm::ivec2>& PathPlanner::getPath() const
+{
+    return _path;
+}
+
+int PathPlanner::getSearchMapState(glm::ivec2 coord) const
+{
+    if (static_cast<int>(_searchMap.size()) != _resolution * _resolution)
+    {
+        return cSearchMapUnvisited;
+    }
+
+    return getSearchMapValue(coord);
+}
+
+int PathPlanner::getMaxDistance() const
+{
+    return _maxDistance;
+}
+
+int PathPlanner::getExpandedNodes() const
+{
+    return _expandedNodes;
+}
+
+void PathPlanner::resetSearch(int resolution)
+{
+    _resolution = resolution;
+    _maxDistance = 0;
+    _expandedNodes = 0;
+    _path.clear();
+
+    ++_searchGeneration;
+    if (_searchGeneration == 0)
+    {
+        _searchGeneration = 1;
+    }
+}
+
+void PathPlanner::resetSearchMap()
+{
+    _searchMap.resize(_resolution * _resolution);
+    resetStamps(_searchMapStamps, _resolution * _resolution);
+}
+
+void PathPlanner::resetTraceback()
+{
+    _searchMapTraceback.resize(_resolution * _resolution);
+    resetStamps(_tracebackStamps, _resolution * _resolution);
+}
+
+glm::ivec2 PathPlanner::wrap(glm::ivec2 coord) const
+{
+    glm::ivec2 wrapped{coord.x % _resolution, coord.y % _resolution};
+
+    if (wrapped.x < 0) { wrapped.x += _resolution; }
+    if (wrapped.y < 0) { wrapped.y += _resolution; }
+
+    return wrapped;
+}
+
+int PathPlanner::getIndex(glm::ivec2 coord) const
+{
+    return _resolution * coord.x + coord.y;
+}
+
+int PathPlanner::getTorusDistance(glm::ivec2 from, glm::ivec2 to) const
+{
+    auto dx = std::abs(from.x - to.x);
+    auto dy = std::abs(from.y - to.y);
+    return std::min(dx, _resolution - dx) + std::min(dy, _resolution - dy);
+}
+
+void PathPlanner::markSearchMap(glm::ivec2 coord, int value)
+{
+    auto index = getIndex(coord);
+    _searchMap[index] = value;
+    _searchMapStamps[index] = _searchGeneration;
+}
+
+int PathPlanner::getSearchMapValue(glm::ivec2 coord) const
+{
+    auto index = getIndex(coord);
+    return _searchMapStamps[index] == _searchGeneration
+        ? _searchMap[index]
+        : cSearchMapUnvisited;
+}
+
+void PathPlanner::setTraceback(int index, glm::ivec2 parent)
+{
+    _searchMapTraceback[index] = parent;
+    _tracebackStamps[index] = _searchGeneration;
+}
+
+glm::ivec2 PathPlanner::getTraceback(int index) const
+{
+    return _tracebackStamps[index] == _searchGeneration
+        ? _searchMapTraceback[index]
+        : glm::ivec2{-1, -1};
+}
+
+void PathPlanner::trackbackAndStorePath(glm::ivec2 end)
+{
+    std::vector<glm::ivec2> newPath;
+    auto current = end;
+    while (current != glm::ivec2{-1, -1})
+    {
+        newPath.push_back(current);
+        current = getTraceback(getIndex(current));
+    }
+
+    _path.clear();
+    std::reverse_copy(
+        std::begin(newPath),
+        std::end(newPath),
+        std::back_inserter(_path)
+    );
+}
+
+void PathPlanner::resetStamps(
+    std::vector<std::uint32_t>& stamps,
+    int count
+) const
+{
+    // The first generation after the counter wraps could meet its own
+    // stamps from long ago, so everything is cleared then.
+    if (static_cast<int>(stamps.size()) != count || _searchGeneration == 1)
+    {
+        stamps.assign(count, 0);
+    }
+}
+
+}
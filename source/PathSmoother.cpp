@@ -0,0 +1,328 @@
+#include "PathSmoother.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace kinematic
+{
+
+const unsigned PathSmoother::cDefaultSeed = 5489u;
+const int PathSmoother::cDefaultIterationLimit = 500;
+const int PathSmoother::cDefaultShortcutCount = 100;
+const int PathSmoother::cDefaultSmoothingPasses = 2;
+const float PathSmoother::cDefaultCollisionStep = 0.01f;
+
+PathSmoother::PathSmoother():
+    _seed{cDefaultSeed},
+    _iterationLimit{cDefaultIterationLimit},
+    _shortcutCount{cDefaultShortcutCount},
+    _smoothingPasses{cDefaultSmoothingPasses},
+    _collisionStep{cDefaultCollisionStep},
+    _motionChecks{0}
+{
+}
+
+PathSmoother::~PathSmoother()
+{
+}
+
+void PathSmoother::setSeed(unsigned seed)
+{
+    _seed = seed;
+}
+
+unsigned PathSmoother::getSeed() const
+{
+    return _seed;
+}
+
+void PathSmoother::setIterationLimit(int iterationLimit)
+{
+    _iterationLimit = iterationLimit;
+}
+
+int PathSmoother::getIterationLimit() const
+{
+    return _iterationLimit;
+}
+
+void PathSmoother::setShortcutCount(int shortcutCount)
+{
+    _shortcutCount = shortcutCount;
+}
+
+int PathSmoother::getShortcutCount() const
+{
+    return _shortcutCount;
+}
+
+void PathSmoother::setSmoothingPasses(int smoothingPasses)
+{
+    _smoothingPasses = smoothingPasses;
+}
+
+int PathSmoother::getSmoothingPasses() const
+{
+    return _smoothingPasses;
+}
+
+void PathSmoother::setCollisionStep(float collisionStep)
+{
+    _collisionStep = collisionStep;
+}
+
+float PathSmoother::getCollisionStep() const
+{
+    return _collisionStep;
+}
+
+void PathSmoother::smooth(
+    const ChainConfigurationSpace& space,
+    std::vector<JointVector>& path
+)
+{
+    _motionChecks = 0;
+    _random.seed(_seed);
+
+    if (path.size() < 3)
+    {
+        return;
+    }
+
+    pruneWaypoints(space, path);
+    shortcutPath(space, path);
+    cutCorners(space, path);
+}
+
+int PathSmoother::getMotionChecks() const
+{
+    return _motionChecks;
+}
+
+std::vector<JointVector> PathSmoother::resample(
+    const std::vector<JointVector>& path,
+    float maxStep
+)
+{
+    std::vector<JointVector> output;
+    if (path.empty())
+    {
+        return output;
+    }
+
+    output.push_back(path.front());
+    for (auto i = 1u; i < path.size(); ++i)
+    {
+        const auto& from = path[i - 1];
+        const auto& to = path[i];
+
+        float longest = 0.0f;
+        for (auto joint = 0u; joint < from.size(); ++joint)
+        {
+            auto delta = ChainConfigurationSpace::getAngleDifference(
+                from[joint],
+                to[joint]
+            );
+            longest = std::max(longest, std::abs(delta));
+        }
+
+        auto steps = static_cast<int>(std::ceil(longest / maxStep));
+        for (auto step = 1; step < steps; ++step)
+        {
+            output.push_back(
+                interpolate(from, to, static_cast<float>(step) / steps)
+            );
+        }
+
+        output.push_back(to);
+    }
+
+    return output;
+}
+
+bool PathSmoother::checkMotion(
+    const ChainConfigurationSpace& space,
+    const JointVector& from,
+    const JointVector& to
+)
+{
+    ++_motionChecks;
+    return space.checkMotion(from.data(), to.data(), _collisionStep);
+}
+
+void PathSmoother::pruneWaypoints(
+    const ChainConfigurationSpace& space,
+    std::vector<JointVector>& path
+)
+{
+    // From each kept waypoint the next one is found by doubling the
+    // lookahead until a move fails and bisecting back, so a long straight
+    // stretch costs a logarithmic number of checks.
+    auto count = static_cast<int>(path.size());
+    _buffer.clear();
+    _buffer.push_back(path.front());
+
+    auto anchor = 0;
+    while (anchor < count - 1)
+    {
+        auto reachable = anchor + 1;
+        auto blocked = count;
+        auto lookahead = 2;
+
+        while (anchor + lookahead < count && hasBudget())
+        {
+            if (!checkMotion(space, path[anchor], path[anchor + lookahead]))
+            {
+                blocked = anchor + lookahead;
+                break;
+            }
+
+            reachable = anchor + lookahead;
+            lookahead *= 2;
+        }
+
+        if (blocked == count && reachable < count - 1 && hasBudget())
+        {
+            if (checkMotion(space, path[anchor], path[count - 1]))
+            {
+                reachable = count - 1;
+            }
+        }
+
+        while (blocked - reachable > 1 && hasBudget())
+        {
+            auto middle = (reachable + blocked) / 2;
+            if (checkMotion(space, path[anchor], path[middle]))
+            {
+                reachable = middle;
+            }
+            else
+            {
+                blocked = middle;
+            }
+        }
+
+        _buffer.push_back(path[reachable]);
+        anchor = reachable;
+    }
+
+    path.swap(_buffer);
+}
+
+void PathSmoother::shortcutPath(
+    const ChainConfigurationSpace& space,
+    std::vector<JointVector>& path
+)
+{
+    for (auto attempt = 0; attempt < _shortcutCount && hasBudget(); ++attempt)
+    {
+        auto segments = static_cast<int>(path.size()) - 1;
+        if (segments < 2)
+        {
+            break;
+        }
+
+        std::uniform_int_distribution<int> segmentDistribution(
+            0,
+            segments - 1
+        );
+        std::uniform_real_distribution<float> offsetDistribution(0.0f, 1.0f);
+
+        auto first = segmentDistribution(_random);
+        auto second = segmentDistribution(_random);
+        if (first == second)
+        {
+            continue;
+        }
+
+        if (first > second)
+        {
+            std::swap(first, second);
+        }
+
+        auto from = interpolate(
+            path[first],
+            path[first + 1],
+            offsetDistribution(_random)
+        );
+        auto to = interpolate(
+            path[second],
+            path[second + 1],
+            offsetDistribution(_random)
+        );
+
+        if (!checkMotion(space, from, to))
+        {
+            continue;
+        }
+
+        _buffer.assign(path.begin(), path.begin() + first + 1);
+        _buffer.push_back(from);
+        _buffer.push_back(to);
+        _buffer.insert(_buffer.end(), path.begin() + second + 1, path.end());
+        path.swap(_buffer);
+    }
+}
+
+void PathSmoother::cutCorners(
+    const ChainConfigurationSpace& space,
+    std::vector<JointVector>& path
+)
+{
+    // Chaikin's scheme: a corner is replaced by two points a quarter of the
+    // way along its edges. Both new points lie on the old path, so only
+    // the move between them has to be checked.
+    const float cCut = 0.25f;
+
+    for (auto pass = 0; pass < _smoothingPasses; ++pass)
+    {
+        auto count = path.size();
+        _buffer.clear();
+        _buffer.push_back(path.front());
+
+        for (auto i = 1u; i + 1 < count; ++i)
+        {
+            auto from = interpolate(path[i], _buffer.back(), cCut);
+            auto to = interpolate(path[i], path[i + 1], cCut);
+
+            if (hasBudget() && checkMotion(space, from, to))
+            {
+                _buffer.push_back(from);
+                _buffer.push_back(to);
+            }
+            else
+            {
+                _buffer.push_back(path[i]);
+            }
+        }
+
+        _buffer.push_back(path.back());
+        path.swap(_buffer);
+    }
+}
+
+bool PathSmoother::hasBudget() const
+{
+    return _motionChecks < _iterationLimit;
+}
+
+JointVector PathSmoother::interpolate(
+    const JointVector& from,
+    const JointVector& to,
+    float t
+)
+{
+    JointVector output(from.size());
+    for (auto joint = 0u; joint < from.size(); ++joint)
+    {
+        output[joint] = ChainConfigurationSpace::wrapAngle(from[joint]
+            + t * ChainConfigurationSpace::getAngleDifference(
+                from[joint],
+                to[joint]
+            ));
+    }
+
+    return output;
+}
+
+}
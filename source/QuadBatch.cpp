@@ -0,0 +1,249 @@
+#include "QuadBatch.hpp"
+
+#include <cstddef>
+
+#include "glm/gtc/type_ptr.hpp"
+#include "easylogging++.h"
+
+namespace kinematic
+{
+
+namespace
+{
+    const char* cVertexShader = R"(
+        #version 330 core
+
+        layout(location = 0) in vec2 corner;
+        layout(location = 1) in vec2 position;
+        layout(location = 2) in vec2 size;
+        layout(location = 3) in vec2 direction;
+        layout(location = 4) in vec4 color;
+
+        uniform mat4 projection;
+
+        out vec4 quadColor;
+
+        void main()
+        {
+            vec2 local = corner * size;
+            vec2 turned = vec2(
+                direction.x * local.x - direction.y * local.y,
+                direction.y * local.x + direction.x * local.y
+            );
+
+            gl_Position = projection * vec4(position + turned, 0.0, 1.0);
+            quadColor = color;
+        }
+    )";
+
+    const char* cFragmentShader = R"(
+        #version 330 core
+
+        in vec4 quadColor;
+        out vec4 fragmentColor;
+
+        void main()
+        {
+            fragmentColor = quadColor;
+        }
+    )";
+
+    const GLfloat cCorners[] = {
+        -0.5f, -0.5f,
+        +0.5f, -0.5f,
+        -0.5f, +0.5f,
+        +0.5f, +0.5f
+    };
+
+    void setInstanceAttribute(GLuint location, GLint size, size_t offset)
+    {
+        glEnableVertexAttribArray(location);
+        glVertexAttribPointer(
+            location,
+            size,
+            GL_FLOAT,
+            GL_FALSE,
+            sizeof(QuadInstance),
+            reinterpret_cast<const void*>(offset)
+        );
+        glVertexAttribDivisor(location, 1);
+    }
+
+    GLuint compileShader(GLenum type, const char* source)
+    {
+        auto shader = glCreateShader(type);
+        glShaderSource(shader, 1, &source, nullptr);
+        glCompileShader(shader);
+
+        GLint compiled = GL_FALSE;
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+        if (compiled != GL_TRUE)
+        {
+            GLchar log[1024];
+            glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+            LOG(ERROR) << "Quad batch shader failed to compile: " << log;
+        }
+
+        return shader;
+    }
+}
+
+QuadBatch::QuadBatch():
+    _changed{false},
+    _program{0},
+    _projectionLocation{-1},
+    _vertexArray{0},
+    _cornerBuffer{0},
+    _instanceBuffer{0}
+{
+}
+
+QuadBatch::~QuadBatch()
+{
+}
+
+void QuadBatch::create()
+{
+    auto vertexShader = compileShader(GL_VERTEX_SHADER, cVertexShader);
+    auto fragmentShader = compileShader(GL_FRAGMENT_SHADER, cFragmentShader);
+
+    _program = glCreateProgram();
+    glAttachShader(_program, vertexShader);
+    glAttachShader(_program, fragmentShader);
+    glLinkProgram(_program);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(_program, GL_LINK_STATUS, &linked);
+    if (linked != GL_TRUE)
+    {
+        GLchar log[1024];
+        glGetProgramInfoLog(_program, sizeof(log), nullptr, log);
+        LOG(ERROR) << "Quad batch program failed to link: " << log;
+    }
+
+    _projectionLocation = glGetUniformLocation(_program, "projection");
+
+    glGenVertexArrays(1, &_vertexArray);
+    glBindVertexArray(_vertexArray);
+
+    glGenBuffers(1, &_cornerBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, _cornerBuffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(cCorners), cCorners, GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+    glGenBuffers(1, &_instanceBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, _instanceBuffer);
+    setInstanceAttribute(1, 2, offsetof(QuadInstance, position));
+    setInstanceAttribute(2, 2, offsetof(QuadInstance, size));
+    setInstanceAttribute(3, 2, offsetof(QuadInstance, direction));
+    setInstanceAttribute(4, 4, offsetof(QuadInstance, color));
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void QuadBatch::destroy()
+{
+    glDeleteBuffers(1, &_instanceBuffer);
+    glDeleteBuffers(1, &_cornerBuffer);
+    glDeleteVertexArrays(1, &_vertexArray);
+    glDeleteProgram(_program);
+
+    _instanceBuffer = 0;
+    _cornerBuffer = 0;
+    _vertexArray = 0;
+    _program = 0;
+}
+
+void QuadBatch::clear()
+{
+    _instances.clear();
+    _changed = true;
+}
+
+void QuadBatch::add(const QuadInstance& instance)
+{
+    _instances.push_back(instance);
+    _changed = true;
+}
+
+void QuadBatch::addQuad(glm::vec2 position, glm::vec2 size, glm::vec4 color)
+{
+    add({position, size, {1.0f, 0.0f}, color});
+}
+
+void QuadBatch::addSegment(
+    glm::vec2 start,
+    glm::vec2 end,
+    float thickness,
+    glm::vec4 color
+)
+{
+    auto delta = end - start;
+    auto length = glm::length(delta);
+    auto direction = length > 0.0f
+        ? delta / length
+        : glm::vec2{1.0f, 0.0f};
+
+    add({(start + end) * 0.5f, {length, thickness}, direction, color});
+}
+
+int QuadBatch::size() const
+{
+    return static_cast<int>(_instances.size());
+}
+
+void QuadBatch::render(const glm::mat4& projection)
+{
+    if (_instances.empty())
+    {
+        return;
+    }
+
+    // All quads go up in one upload; a fresh store each time lets the
+    // driver keep the previous frame's copy in flight.
+    if (_changed)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, _instanceBuffer);
+        glBufferData(
+            GL_ARRAY_BUFFER,
+            _instances.size() * sizeof(QuadInstance),
+            _instances.data(),
+            GL_STREAM_DRAW
+        );
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        _changed = false;
+    }
+
+    auto blendEnabled = glIsEnabled(GL_BLEND);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    glUseProgram(_program);
+    glUniformMatrix4fv(
+        _projectionLocation,
+        1,
+        GL_FALSE,
+        glm::value_ptr(projection)
+    );
+
+    glBindVertexArray(_vertexArray);
+    glDrawArraysInstanced(
+        GL_TRIANGLE_STRIP,
+        0,
+        4,
+        static_cast<GLsizei>(_instances.size())
+    );
+    glBindVertexArray(0);
+    glUseProgram(0);
+
+    if (!blendEnabled)
+    {
+        glDisable(GL_BLEND);
+    }
+}
+
+}
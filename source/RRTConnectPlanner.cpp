@@ -0,0 +1,215 @@
+#include "RRTConnectPlanner.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "glm/gtc/constants.hpp"
+
+namespace kinematic
+{
+
+const unsigned RRTConnectPlanner::cDefaultSeed = 5489u;
+const int RRTConnectPlanner::cDefaultIterationLimit = 20000;
+const float RRTConnectPlanner::cDefaultStepSize = 0.3f;
+const float RRTConnectPlanner::cDefaultCollisionStep = 0.01f;
+
+RRTConnectPlanner::RRTConnectPlanner():
+    _seed{cDefaultSeed},
+    _iterationLimit{cDefaultIterationLimit},
+    _stepSize{cDefaultStepSize},
+    _collisionStep{cDefaultCollisionStep}
+{
+}
+
+RRTConnectPlanner::~RRTConnectPlanner()
+{
+}
+
+void RRTConnectPlanner::setSeed(unsigned seed)
+{
+    _seed = seed;
+}
+
+unsigned RRTConnectPlanner::getSeed() const
+{
+    return _seed;
+}
+
+void RRTConnectPlanner::setIterationLimit(int iterationLimit)
+{
+    _iterationLimit = iterationLimit;
+}
+
+int RRTConnectPlanner::getIterationLimit() const
+{
+    return _iterationLimit;
+}
+
+void RRTConnectPlanner::setStepSize(float stepSize)
+{
+    _stepSize = stepSize;
+}
+
+float RRTConnectPlanner::getStepSize() const
+{
+    return _stepSize;
+}
+
+void RRTConnectPlanner::setCollisionStep(float collisionStep)
+{
+    _collisionStep = collisionStep;
+}
+
+float RRTConnectPlanner::getCollisionStep() const
+{
+    return _collisionStep;
+}
+
+bool RRTConnectPlanner::findPath(
+    const ChainConfigurationSpace& space,
+    const JointVector& start,
+    const JointVector& goal
+)
+{
+    resetSearch();
+
+    auto dimension = space.getDimension();
+    if (!space.checkConfiguration(start) || !space.checkConfiguration(goal))
+    {
+        return false;
+    }
+
+    JointVector root(dimension), sample(dimension);
+    _extension.resize(dimension);
+
+    for (auto i = 0; i < 2; ++i)
+    {
+        const auto& configuration = i == 0 ? start : goal;
+        std::transform(
+            std::begin(configuration),
+            std::end(configuration),
+            std::begin(root),
+            &ChainConfigurationSpace::wrapAngle
+        );
+
+        _trees[i].index.reset(dimension);
+        _trees[i].index.insert(root.data());
+        _trees[i].parents.assign(1, -1);
+    }
+
+    std::mt19937 generator{_seed};
+    std::uniform_real_distribution<float> angle{0.0f, glm::two_pi<float>()};
+
+    for (auto iteration = 0; iteration < _iterationLimit; ++iteration)
+    {
+        auto& grown = _trees[iteration % 2];
+        auto& other = _trees[1 - iteration % 2];
+
+        for (auto& value: sample)
+        {
+            value = angle(generator);
+        }
+
+        bool reached = false;
+        auto added = extend(space, grown, sample.data(), reached);
+        if (added < 0)
+        {
+            continue;
+        }
+
+        // Greedily pull the other tree towards the new node.
+        auto target = grown.index.getPoint(added);
+        auto connected = -1;
+        reached = false;
+        while (!reached)
+        {
+            auto next = extend(space, other, target, reached);
+            if (next < 0)
+            {
+                break;
+            }
+
+            connected = next;
+        }
+
+        if (!reached || connected < 0)
+        {
+            continue;
+        }
+
+        auto startNode = iteration % 2 == 0 ? added : connected;
+        auto goalNode = iteration % 2 == 0 ? connected : added;
+
+        appendBranch(_trees[0], startNode, false);
+        _path.pop_back();
+        appendBranch(_trees[1], goalNode, true);
+        return true;
+    }
+
+    return false;
+}
+
+int RRTConnectPlanner::extend(
+    const ChainConfigurationSpace& space,
+    Tree& tree,
+    const float* target,
+    bool& reached
+)
+{
+    auto dimension = space.getDimension();
+    auto nearest = tree.index.findNearest(target);
+    auto from = tree.index.getPoint(nearest);
+
+    float longest = 0.0f;
+    for (auto joint = 0; joint < dimension; ++joint)
+    {
+        _extension[joint] = ChainConfigurationSpace::getAngleDifference(
+            from[joint],
+            target[joint]
+        );
+        longest = std::max(longest, std::abs(_extension[joint]));
+    }
+
+    reached = longest <= _stepSize;
+    auto scale = reached ? 1.0f : _stepSize / longest;
+
+    for (auto joint = 0; joint < dimension; ++joint)
+    {
+        _extension[joint] = ChainConfigurationSpace::wrapAngle(
+            from[joint] + scale * _extension[joint]
+        );
+    }
+
+    if (!space.checkMotion(from, _extension.data(), _collisionStep))
+    {
+        reached = false;
+        return -1;
+    }
+
+    ++_expandedNodes;
+    tree.parents.push_back(nearest);
+    return tree.index.insert(_extension.data());
+}
+
+void RRTConnectPlanner::appendBranch(
+    const Tree& tree,
+    int node,
+    bool towardsRoot
+)
+{
+    auto dimension = tree.index.getDimension();
+    auto first = _path.size();
+
+    for (; node >= 0; node = tree.parents[node])
+    {
+        auto point = tree.index.getPoint(node);
+        _path.emplace_back(point, point + dimension);
+    }
+
+    if (!towardsRoot)
+    {
+        std::reverse(std::begin(_path) + first, std::end(_path));
+    }
+}
+
+}
@@ -0,0 +1,272 @@
+#include "ReachabilityMap.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+#include "InverseKinematics.hpp"
+
+namespace kinematic
+{
+
+namespace
+{
+    // Samples along each side of a tile; one tile is solved as a batch in
+    // buffers on the stack.
+    const int cTileSize = 16;
+    const int cTileSamples = cTileSize * cTileSize;
+
+    bool areSameBoxes(
+        const std::vector<fw::AABB<glm::vec2>>& first,
+        const std::vector<fw::AABB<glm::vec2>>& second
+    )
+    {
+        if (first.size() != second.size())
+        {
+            return false;
+        }
+
+        for (auto i = 0u; i < first.size(); ++i)
+        {
+            if (first[i].min != second[i].min || first[i].max != second[i].max)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+const int ReachabilityMap::cDefaultColumns = 256;
+const int ReachabilityMap::cDefaultRows = 256;
+
+ReachabilityMap::ReachabilityMap():
+    _columns{cDefaultColumns},
+    _rows{cDefaultRows},
+    _firstArmLength{0.0f},
+    _secondArmLength{0.0f},
+    _valid{false},
+    _componentsRevision{0},
+    _componentsValid{false}
+{
+}
+
+ReachabilityMap::~ReachabilityMap()
+{
+}
+
+void ReachabilityMap::setResolution(int columns, int rows)
+{
+    if (_columns == columns && _rows == rows)
+    {
+        return;
+    }
+
+    _columns = columns;
+    _rows = rows;
+    _valid = false;
+}
+
+int ReachabilityMap::getColumns() const
+{
+    return _columns;
+}
+
+int ReachabilityMap::getRows() const
+{
+    return _rows;
+}
+
+bool ReachabilityMap::create(
+    const ConfigurationSpace& space,
+    const fw::AABB<glm::vec2>& area,
+    JobProgress* progress
+)
+{
+    _firstArmLength = space.getFirstArmLength();
+    _secondArmLength = space.getSecondArmLength();
+    _constraints = space.getConstraints();
+    _area = area;
+    _valid = true;
+
+    updateComponents(space);
+
+    _solutionCounts.assign(_columns * _rows, 0);
+    _connected.assign(_columns * _rows, 0);
+
+    auto tileColumns = (_columns + cTileSize - 1) / cTileSize;
+    auto tileRows = (_rows + cTileSize - 1) / cTileSize;
+    auto tileCount = tileColumns * tileRows;
+
+    std::atomic<int> finishedTiles{0};
+    space.getThreadPool()->parallelFor(
+        0,
+        tileCount,
+        1,
+        [&](int firstTile, int lastTile)
+        {
+            if (progress != nullptr && progress->isCancelled())
+            {
+                return;
+            }
+
+            for (auto tile = firstTile; tile < lastTile; ++tile)
+            {
+                createTile(space, tile);
+            }
+
+            if (progress != nullptr)
+            {
+                finishedTiles += lastTile - firstTile;
+                progress->setProgress(
+                    static_cast<float>(finishedTiles) / tileCount
+                );
+            }
+        }
+    );
+
+    if (progress != nullptr && progress->isCancelled())
+    {
+        _valid = false;
+        return false;
+    }
+
+    return true;
+}
+
+bool ReachabilityMap::isValid(
+    const ConfigurationSpace& space,
+    const fw::AABB<glm::vec2>& area
+) const
+{
+    // Components follow the map, which may be calculated or dropped
+    // without the obstacles changing.
+    auto componentsMatch = space.isAvailabilityMapCreated()
+        ? _componentsValid && _componentsRevision == space.getRevision()
+        : !_componentsValid;
+
+    return _valid
+        && _firstArmLength == space.getFirstArmLength()
+        && _secondArmLength == space.getSecondArmLength()
+        && _area.min == area.min
+        && _area.max == area.max
+        && componentsMatch
+        && areSameBoxes(_constraints, space.getConstraints());
+}
+
+void ReachabilityMap::invalidate()
+{
+    _valid = false;
+}
+
+glm::vec2 ReachabilityMap::getSamplePosition(int column, int row) const
+{
+    auto size = _area.max - _area.min;
+    return _area.min + glm::vec2{
+        (column + 0.5f) * size.x / _columns,
+        (row + 0.5f) * size.y / _rows
+    };
+}
+
+int ReachabilityMap::getSolutionCount(int column, int row) const
+{
+    return _solutionCounts[row * _columns + column];
+}
+
+bool ReachabilityMap::areSolutionsConnected(int column, int row) const
+{
+    return _connected[row * _columns + column] != 0;
+}
+
+void ReachabilityMap::updateComponents(const ConfigurationSpace& space)
+{
+    _componentsValid = space.isAvailabilityMapCreated();
+    if (!_componentsValid || _componentsRevision == space.getRevision())
+    {
+        return;
+    }
+
+    _components.build(space.getOccupancyGrid(), *space.getThreadPool());
+    _componentsRevision = space.getRevision();
+}
+
+void ReachabilityMap::createTile(const ConfigurationSpace& space, int tile)
+{
+    float targetX[cTileSamples], targetY[cTileSamples];
+    float alpha[2][cTileSamples], beta[2][cTileSamples];
+    unsigned char reachable[cTileSamples];
+    int cells[cTileSamples];
+
+    auto tileColumns = (_columns + cTileSize - 1) / cTileSize;
+    auto firstColumn = (tile % tileColumns) * cTileSize;
+    auto firstRow = (tile / tileColumns) * cTileSize;
+    auto lastColumn = std::min(firstColumn + cTileSize, _columns);
+    auto lastRow = std::min(firstRow + cTileSize, _rows);
+
+    auto count = 0;
+    for (auto row = firstRow; row < lastRow; ++row)
+    {
+        for (auto column = firstColumn; column < lastColumn; ++column)
+        {
+            auto position = getSamplePosition(column, row);
+            targetX[count] = position.x;
+            targetY[count] = position.y;
+            cells[count] = row * _columns + column;
+            ++count;
+        }
+    }
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    solveInverseKinematics(
+        _firstArmLength,
+        _secondArmLength,
+        targetX,
+        targetY,
+        count,
+        {{alpha[0], alpha[1]}, {beta[0], beta[1]}, reachable}
+    );
+
+    for (auto i = 0; i < count; ++i)
+    {
+        if (!reachable[i])
+        {
+            continue;
+        }
+
+        bool free[2];
+        for (auto side = 0; side < 2; ++side)
+        {
+            free[side] = space.checkConfiguration(
+                alpha[side][i],
+                beta[side][i]
+            );
+        }
+
+        _solutionCounts[cells[i]] = static_cast<unsigned char>(
+            (free[0] ? 1 : 0) + (free[1] ? 1 : 0)
+        );
+
+        if (!free[0] || !free[1] || !_componentsValid)
+        {
+            continue;
+        }
+
+        // The closest cells stand in for the exact configurations. Cells
+        // are conservative, so a free configuration may land in an
+        // occupied one and then counts as not connected.
+        auto first = space.getClosestInConfiguration(
+            {alpha[0][i], beta[0][i]}
+        );
+        auto second = space.getClosestInConfiguration(
+            {alpha[1][i], beta[1][i]}
+        );
+
+        _connected[cells[i]] = _components.areConnected(first, second) ? 1 : 0;
+    }
+}
+
+}
@@ -1,4 +1,5 @@
 #include "RoboticArmController.hpp"
+#include <string>
 #include "glm/gtc/type_ptr.hpp"
 #include "imgui.h"
 #include "fw/GeometricIntersections.hpp"
@@ -6,9 +7,16 @@
 namespace kinematic
 {
 
+namespace
+{
+    const int cMinJointCount = 2;
+    const int cMaxJointCount = 6;
+    const float cNewLinkLength = 0.2f;
+}
+
 RoboticArmController::RoboticArmController():
-    _firstArmLength{0.3f},
-    _secondArmLength{0.3f},
+    _linkLengths{0.3f, 0.3f},
+    _jointAngles{0.0f, 0.0f},
     _thickness{0.01f},
     _lastSolveResult{true}
 {
@@ -29,29 +37,41 @@ void RoboticArmController::update(
         return;
     }
 
-    ImGui::DragFloat(
-        "First arm length",
-        &_firstArmLength,
-        0.01f,
-        0.0f,
-        100.0f
-    );
+    int jointCount = getJointCount();
+    if (ImGui::SliderInt("Joints", &jointCount, cMinJointCount, cMaxJointCount))
+    {
+        _linkLengths.resize(jointCount, cNewLinkLength);
+        _jointAngles.resize(jointCount, 0.0f);
+    }
 
-    ImGui::DragFloat(
-        "Second arm length",
-        &_secondArmLength,
-        0.01f,
-        0.0f,
-        100.0f
-    );
+    for (auto i = 0; i < getJointCount(); ++i)
+    {
+        auto label = "Link " + std::to_string(i + 1) + " length";
+        ImGui::DragFloat(label.c_str(), &_linkLengths[i], 0.01f, 0.0f, 100.0f);
+    }
 
     if (ImGui::CollapsingHeader("Forward kinematics"))
     {
-        ImGui::DragFloat("Alpha (rad)", &_solutions[0].first, 0.01f);
-        ImGui::DragFloat("Beta (rad)", &_solutions[0].second, 0.01f);
+        if (getJointCount() == 2)
+        {
+            ImGui::DragFloat("Alpha (rad)", &_solutions[0].first, 0.01f);
+            ImGui::DragFloat("Beta (rad)", &_solutions[0].second, 0.01f);
+        }
+        else
+        {
+            for (auto i = 0; i < getJointCount(); ++i)
+            {
+                auto label = "Joint " + std::to_string(i + 1) + " (rad)";
+                ImGui::DragFloat(label.c_str(), &_jointAngles[i], 0.01f);
+            }
+        }
     }
 
-    if (ImGui::CollapsingHeader("Inverse kinematics"))
+    if (getJointCount() != 2)
+    {
+        ImGui::Text("Inverse kinematics needs exactly two links.");
+    }
+    else if (ImGui::CollapsingHeader("Inverse kinematics"))
     {
         ImGui::DragFloat2("Target", glm::value_ptr(_ikTarget), 0.1f);
         if (ImGui::Button("Reach target"))
@@ -94,11 +114,16 @@ const std::vector<std::pair<float, float>>& RoboticArmController::getSolutions(
 
 bool RoboticArmController::solveInverseKinematics()
 {
+    if (getJointCount() != 2)
+    {
+        return false;
+    }
+
     auto intersections = fw::intersectCircles<glm::vec2, float>(
         {0, 0},
-        _firstArmLength,
+        getFirstArmLength(),
         _ikTarget,
-        _secondArmLength
+        getSecondArmLength()
     );
 
     if (intersections.size() == 0)
@@ -121,14 +146,64 @@ bool RoboticArmController::solveInverseKinematics()
     return true;
 }
 
+int RoboticArmController::solveInverseKinematics(
+    const float* targetX,
+    const float* targetY,
+    int count,
+    const InverseKinematicsBuffers& output
+) const
+{
+    return kinematic::solveInverseKinematics(
+        getFirstArmLength(),
+        getSecondArmLength(),
+        targetX,
+        targetY,
+        count,
+        output
+    );
+}
+
+int RoboticArmController::getJointCount() const
+{
+    return static_cast<int>(_linkLengths.size());
+}
+
+KinematicChain RoboticArmController::getChain() const
+{
+    KinematicChain chain;
+    chain.setLinkLengths(_linkLengths);
+    return chain;
+}
+
+JointVector RoboticArmController::getJointAngles() const
+{
+    if (getJointCount() == 2)
+    {
+        return {_solutions[0].first, _solutions[0].second};
+    }
+
+    return _jointAngles;
+}
+
+void RoboticArmController::setJointAngles(const JointVector& angles)
+{
+    if (getJointCount() == 2)
+    {
+        _solutions[0] = {angles[0], angles[1]};
+        return;
+    }
+
+    _jointAngles = angles;
+}
+
 float RoboticArmController::getFirstArmLength() const
 {
-    return _firstArmLength;
+    return _linkLengths[0];
 }
 
 float RoboticArmController::getSecondArmLength() const
 {
-    return _secondArmLength;
+    return _linkLengths[1];
 }
 
 void RoboticArmController::setTarget(const glm::vec2& position)
@@ -144,13 +219,13 @@ std::pair<glm::vec2, glm::vec2> RoboticArmController::buildConfiguration(
     glm::vec2 p0{0.0f, 0.0f};
 
     glm::vec2 p1 = p0 + glm::vec2{
-        _firstArmLength * cosf(alpha),
-        _firstArmLength * sinf(alpha)
+        getFirstArmLength() * cosf(alpha),
+        getFirstArmLength() * sinf(alpha)
     };
 
     glm::vec2 p2 = p1 + glm::vec2{
-        _secondArmLength * cosf(alpha + beta),
-        _secondArmLength * sinf(alpha + beta)
+        getSecondArmLength() * cosf(alpha + beta),
+        getSecondArmLength() * sinf(alpha + beta)
     };
 
     return {p1, p2};
@@ -1,19 +1,12 @@
 #include "RoboticArmRendering.hpp"
-#include <cmath>
-#include "glm/gtc/matrix_transform.hpp"
-#include "fw/DebugShapes.hpp"
 
 namespace kinematic
 {
 
 RoboticArmRendering::RoboticArmRendering():
     _armsThickness{0.05f},
-    _firstArmLength{0.5f},
-    _secondArmLength{0.5f},
-    _alphaAngle{},
-    _betaAngle{}
+    _jointAngles{0.0f, 0.0f}
 {
-    _quad = fw::createQuad2D({1.0f, 1.0f});
 }
 
 RoboticArmRendering::~RoboticArmRendering()
@@ -25,76 +18,81 @@ void RoboticArmRendering::setArmsThickness(float thickness)
     _armsThickness = thickness;
 }
 
-void RoboticArmRendering::setFirstArmLength(float length)
+void RoboticArmRendering::setChain(const KinematicChain& chain)
 {
-    _firstArmLength = length;
+    _chain = chain;
 }
 
-void RoboticArmRendering::setSecondArmLength(float length)
+void RoboticArmRendering::setJointAngles(const JointVector& angles)
 {
-    _secondArmLength = length;
+    _jointAngles = angles;
 }
 
-void RoboticArmRendering::setAlphaAngle(float alphaAngle)
+void RoboticArmRendering::render(QuadBatch& batch, const glm::vec4& color)
 {
-    _alphaAngle = alphaAngle;
+    auto jointCount = _chain.getJointCount();
+    _jointAngles.resize(jointCount, 0.0f);
+    _jointPositions.resize(jointCount + 1);
+    _chain.computeJointPositions(_jointAngles.data(), _jointPositions.data());
+
+    for (auto i = 0; i < jointCount; ++i)
+    {
+        batch.addSegment(
+            _jointPositions[i],
+            _jointPositions[i + 1],
+            _armsThickness,
+            color
+        );
+    }
 }
 
-void RoboticArmRendering::setBetaAngle(float betaAngle)
+void RoboticArmRendering::renderPath(
+    QuadBatch& batch,
+    const std::vector<JointVector>& path,
+    const glm::vec4& firstColor,
+    const glm::vec4& lastColor
+)
 {
-    _betaAngle = betaAngle;
-}
-
-std::vector<fw::GeometryChunk> RoboticArmRendering::render()
-{
-    glm::vec2 p0{0.0f, 0.0f};
-
-    glm::vec2 p1 = p0 + glm::vec2{
-        _firstArmLength * cosf(_alphaAngle),
-        _firstArmLength * sinf(_alphaAngle)
-    };
-
-    glm::vec2 p2 = p1 + glm::vec2{
-        _secondArmLength * cosf(_alphaAngle + _betaAngle),
-        _secondArmLength * sinf(_alphaAngle + _betaAngle)
-    };
-
-    glm::mat4 firstTransform = glm::translate(
-        glm::mat4{},
-        glm::vec3{(p0 + p1) / 2.0f, 0.0f}
-    );
-
-    firstTransform = glm::rotate(
-        firstTransform,
-        _alphaAngle,
-        {0.0f, 0.0f, 1.0f}
-    );
-
-    firstTransform = glm::scale(
-        firstTransform,
-        {_firstArmLength, _armsThickness, 1.0f}
-    );
-
-    glm::mat4 secondTransform = glm::translate(
-        glm::mat4{},
-        glm::vec3{(p1 + p2) / 2.0f, 0.0f}
-    );
-
-    secondTransform = glm::rotate(
-        secondTransform,
-        _alphaAngle + _betaAngle,
-        {0.0f, 0.0f, 1.0f}
-    );
-
-    secondTransform = glm::scale(
-        secondTransform,
-        {_secondArmLength, _armsThickness, 1.0f}
+    // Forward kinematics of all poses in one batched pass, laid out joint
+    // major as computeJointPositions wants it.
+    auto jointCount = _chain.getJointCount();
+    auto count = static_cast<int>(path.size());
+
+    _pathAngles.resize(jointCount * count);
+    for (auto pose = 0; pose < count; ++pose)
+    {
+        for (auto joint = 0; joint < jointCount; ++joint)
+        {
+            _pathAngles[joint * count + pose] = path[pose][joint];
+        }
+    }
+
+    _pathX.resize((jointCount + 1) * count);
+    _pathY.resize((jointCount + 1) * count);
+    _chain.computeJointPositions(
+        _pathAngles.data(),
+        count,
+        _pathX.data(),
+        _pathY.data()
     );
 
-    return {
-        { _quad, nullptr, glm::mat4{firstTransform} },
-        { _quad, nullptr, glm::mat4{secondTransform} }
-    };
+    for (auto pose = 0; pose < count; ++pose)
+    {
+        auto t = count > 1 ? static_cast<float>(pose) / (count - 1) : 1.0f;
+        auto color = glm::mix(firstColor, lastColor, t);
+
+        for (auto joint = 0; joint < jointCount; ++joint)
+        {
+            auto start = joint * count + pose;
+            auto end = start + count;
+            batch.addSegment(
+                {_pathX[start], _pathY[start]},
+                {_pathX[end], _pathY[end]},
+                _armsThickness,
+                color
+            );
+        }
+    }
 }
 
 }
@@ -0,0 +1,99 @@
+#include "SearchWorkspace.hpp"
+
+#include <algorithm>
+
+namespace kinematic
+{
+
+SearchWorkspace::SearchWorkspace():
+    _cellCount{0},
+    _generation{0},
+    _frontierMask{0},
+    _frontierHead{0},
+    _frontierTail{0}
+{
+}
+
+SearchWorkspace::~SearchWorkspace()
+{
+}
+
+void SearchWorkspace::reset(int cellCount)
+{
+    if (cellCount != _cellCount)
+    {
+        _cellCount = cellCount;
+        _generation = 0;
+        _visitedGeneration.assign(cellCount, 0);
+        _directions.assign((cellCount + 3) / 4, 0);
+
+        std::uint32_t capacity = 1;
+        while (capacity < static_cast<std::uint32_t>(cellCount))
+        {
+            capacity <<= 1;
+        }
+
+        _frontier.assign(capacity, 0);
+        _frontierMask = capacity - 1;
+    }
+
+    ++_generation;
+    if (_generation == 0)
+    {
+        std::fill(
+            std::begin(_visitedGeneration),
+            std::end(_visitedGeneration),
+            0
+        );
+        _generation = 1;
+    }
+
+    _frontierHead = 0;
+    _frontierTail = 0;
+}
+
+bool SearchWorkspace::isVisited(std::uint32_t cell) const
+{
+    return _visitedGeneration[cell] == _generation;
+}
+
+void SearchWorkspace::visit(std::uint32_t cell, int direction)
+{
+    _visitedGeneration[cell] = _generation;
+
+    auto shift = 2 * (cell % 4);
+    auto& packed = _directions[cell / 4];
+    packed = static_cast<std::uint8_t>(
+        (packed & ~(3u << shift)) | ((direction & 3u) << shift)
+    );
+}
+
+int SearchWorkspace::getDirection(std::uint32_t cell) const
+{
+    return (_directions[cell / 4] >> (2 * (cell % 4))) & 3;
+}
+
+bool SearchWorkspace::isFrontierEmpty() const
+{
+    return _frontierHead == _frontierTail;
+}
+
+void SearchWorkspace::pushFrontier(std::uint32_t cell)
+{
+    _frontier[_frontierTail & _frontierMask] = cell;
+    ++_frontierTail;
+}
+
+std::uint32_t SearchWorkspace::popFrontier()
+{
+    auto cell = _frontier[_frontierHead & _frontierMask];
+    ++_frontierHead;
+    return cell;
+}
+
+std::uint32_t SearchWorkspace::getFrontierSize() const
+{
+    return _frontierTail - _frontierHead;
+}
+
+}
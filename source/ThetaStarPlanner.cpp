@@ -0,0 +1,310 @@
+#include "ThetaStarPlanner.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+
+#include "glm/gtc/constants.hpp"
+
+namespace kinematic
+{
+
+namespace
+{
+    struct OpenNode
+    {
+        float estimate;
+        float cost;
+        int index;
+
+        bool operator>(const OpenNode& other) const
+        {
+            if (estimate != other.estimate)
+            {
+                return estimate > other.estimate;
+            }
+
+            return cost < other.cost;
+        }
+    };
+
+    const int dirx[] = {-1, 0, +1, 0, -1, +1, +1, -1};
+    const int diry[] = {0, -1, 0, +1, -1, -1, +1, +1};
+}
+
+const int ThetaStarPlanner::cDefaultSightLimit = 64;
+
+ThetaStarPlanner::ThetaStarPlanner():
+    _anyAngle{true},
+    _sightLimit{cDefaultSightLimit},
+    _space{nullptr},
+    _spaceRevision{0}
+{
+}
+
+ThetaStarPlanner::~ThetaStarPlanner()
+{
+}
+
+void ThetaStarPlanner::setAnyAngle(bool anyAngle)
+{
+    _anyAngle = anyAngle;
+}
+
+bool ThetaStarPlanner::isAnyAngle() const
+{
+    return _anyAngle;
+}
+
+void ThetaStarPlanner::setSightLimit(int sightLimit)
+{
+    _sightLimit = sightLimit;
+}
+
+int ThetaStarPlanner::getSightLimit() const
+{
+    return _sightLimit;
+}
+
+bool ThetaStarPlanner::findPath(
+    const ConfigurationSpace& space,
+    glm::ivec2 start,
+    glm::ivec2 end
+)
+{
+    resetSearch(space.getResolution());
+    resetSearchMap();
+    resetTraceback();
+
+    auto cellCount = _resolution * _resolution;
+    _costs.resize(cellCount);
+    resetStamps(_costStamps, cellCount);
+    resetStamps(_closedStamps, cellCount);
+
+    updateComponents(space);
+    if (!_components.areConnected(start, end))
+    {
+        return false;
+    }
+
+    std::priority_queue<
+        OpenNode,
+        std::vector<OpenNode>,
+        std::greater<OpenNode>
+    > openSet;
+
+    setCost(getIndex(start), 0.0f);
+    openSet.push({getHeuristic(start, end), 0.0f, getIndex(start)});
+    markSearchMap(start, 0);
+
+    bool found = false;
+    while (!openSet.empty())
+    {
+        auto node = openSet.top();
+        openSet.pop();
+
+        if (isClosed(node.index) || node.cost != getCost(node.index))
+        {
+            continue;
+        }
+
+        glm::ivec2 current{node.index / _resolution, node.index % _resolution};
+        if (_anyAngle)
+        {
+            updateParent(space, current);
+        }
+
+        _closedStamps[node.index] = _searchGeneration;
+
+        if (current == end)
+        {
+            found = true;
+            break;
+        }
+
+        ++_expandedNodes;
+        _maxDistance = std::max(
+            _maxDistance,
+            static_cast<int>(std::ceil(getCost(node.index)))
+        );
+
+        // Neighbours are one step from the cell, so keeping the parent
+        // within the limit keeps their lines within it too.
+        auto parent = current;
+        auto grandparent = getTraceback(node.index);
+        if (_anyAngle && grandparent != glm::ivec2{-1, -1})
+        {
+            auto offset = glm::abs(getTorusOffset(grandparent, current));
+            if (std::max(offset.x, offset.y) < _sightLimit)
+            {
+                parent = grandparent;
+            }
+        }
+
+        auto parentCost = getCost(getIndex(parent));
+        for (auto i = 0; i < 8; ++i)
+        {
+            if (!canMove(space, current, i)) { continue; }
+
+            auto next = wrap({current.x + dirx[i], current.y + diry[i]});
+            auto nextIndex = getIndex(next);
+            if (isClosed(nextIndex)) { continue; }
+
+            auto cost = parentCost + getTravel(parent, next);
+            if (cost < getCost(nextIndex))
+            {
+                setCost(nextIndex, cost);
+                setTraceback(nextIndex, parent);
+                markSearchMap(next, static_cast<int>(std::round(cost)));
+                openSet.push({cost + getHeuristic(next, end), cost, nextIndex});
+            }
+        }
+    }
+
+    if (found)
+    {
+        trackbackAndStorePath(end);
+    }
+
+    return found;
+}
+
+void ThetaStarPlanner::updateComponents(const ConfigurationSpace& space)
+{
+    if (_space == &space && _spaceRevision == space.getRevision())
+    {
+        return;
+    }
+
+    _space = &space;
+    _spaceRevision = space.getRevision();
+
+    _components.build(space.getOccupancyGrid(), *space.getThreadPool());
+}
+
+bool ThetaStarPlanner::canMove(
+    const ConfigurationSpace& space,
+    glm::ivec2 from,
+    int direction
+) const
+{
+    auto dx = dirx[direction];
+    auto dy = diry[direction];
+
+    if (!space.verifyAvailability(wrap({from.x + dx, from.y + dy})))
+    {
+        return false;
+    }
+
+    if (dx == 0 || dy == 0)
+    {
+        return true;
+    }
+
+    return space.verifyAvailability(wrap({from.x + dx, from.y}))
+        && space.verifyAvailability(wrap({from.x, from.y + dy}));
+}
+
+bool ThetaStarPlanner::hasLineOfSight(
+    const ConfigurationSpace& space,
+    glm::ivec2 from,
+    glm::ivec2 to
+) const
+{
+    return space.checkCellLine(
+        glm::vec2{from},
+        glm::vec2{getTorusOffset(from, to)}
+    );
+}
+
+void ThetaStarPlanner::updateParent(
+    const ConfigurationSpace& space,
+    glm::ivec2 current
+)
+{
+    // The parent was assumed visible when the cell was queued. If it is
+    // not, fall back to the best expanded neighbour, which always exists
+    // since the cell was queued from one of them.
+    auto index = getIndex(current);
+    auto parent = getTraceback(index);
+    if (parent == glm::ivec2{-1, -1} || hasLineOfSight(space, parent, current))
+    {
+        return;
+    }
+
+    setCost(index, std::numeric_limits<float>::infinity());
+    for (auto i = 0; i < 8; ++i)
+    {
+        if (!canMove(space, current, i)) { continue; }
+
+        auto neighbour = wrap({current.x + dirx[i], current.y + diry[i]});
+        auto neighbourIndex = getIndex(neighbour);
+        if (!isClosed(neighbourIndex)) { continue; }
+
+        auto cost = getCost(neighbourIndex) + getTravel(neighbour, current);
+        if (cost < getCost(index))
+        {
+            setCost(index, cost);
+            setTraceback(index, neighbour);
+        }
+    }
+
+    markSearchMap(current, static_cast<int>(std::round(getCost(index))));
+}
+
+glm::ivec2 ThetaStarPlanner::getTorusOffset(
+    glm::ivec2 from,
+    glm::ivec2 to
+) const
+{
+    auto offset = to - from;
+    auto half = _resolution / 2;
+
+    if (offset.x > half) { offset.x -= _resolution; }
+    if (offset.x < -half) { offset.x += _resolution; }
+    if (offset.y > half) { offset.y -= _resolution; }
+    if (offset.y < -half) { offset.y += _resolution; }
+
+    return offset;
+}
+
+float ThetaStarPlanner::getCost(int index) const
+{
+    return _costStamps[index] == _searchGeneration
+        ? _costs[index]
+        : std::numeric_limits<float>::infinity();
+}
+
+void ThetaStarPlanner::setCost(int index, float cost)
+{
+    _costs[index] = cost;
+    _costStamps[index] = _searchGeneration;
+}
+
+bool ThetaStarPlanner::isClosed(int index) const
+{
+    return _closedStamps[index] == _searchGeneration;
+}
+
+float ThetaStarPlanner::getTravel(glm::ivec2 from, glm::ivec2 to) const
+{
+    return glm::length(glm::vec2{getTorusOffset(from, to)});
+}
+
+float ThetaStarPlanner::getHeuristic(glm::ivec2 from, glm::ivec2 to) const
+{
+    if (_anyAngle)
+    {
+        return getTravel(from, to);
+    }
+
+    // Octile distance: diagonal steps first, then straight ones.
+    auto offset = glm::abs(getTorusOffset(from, to));
+    auto diagonal = std::min(offset.x, offset.y);
+    auto straight = std::max(offset.x, offset.y) - diagonal;
+    return diagonal * glm::root_two<float>() + straight;
+}
+
+}
@@ -0,0 +1,162 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace kinematic
+{
+
+namespace
+{
+    thread_local bool tInsideThreadPool = false;
+}
+
+ThreadPool::ThreadPool(unsigned int threadCount):
+    _body{nullptr},
+    _begin{0},
+    _end{0},
+    _grainSize{1},
+    _chunkCount{0},
+    _nextChunk{0},
+    _generation{0},
+    _activeWorkers{0},
+    _stopping{false}
+{
+    if (threadCount == 0)
+    {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // The thread calling parallelFor takes part in the work as well.
+    for (auto i = 1u; i < threadCount; ++i)
+    {
+        _workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _stopping = true;
+    }
+
+    _jobAvailable.notify_all();
+    for (auto& worker: _workers)
+    {
+        worker.join();
+    }
+}
+
+std::shared_ptr<ThreadPool> ThreadPool::getShared()
+{
+    static auto shared = std::make_shared<ThreadPool>();
+    return shared;
+}
+
+unsigned int ThreadPool::getThreadCount() const
+{
+    return static_cast<unsigned int>(_workers.size()) + 1;
+}
+
+void ThreadPool::parallelFor(
+    int begin,
+    int end,
+    int grainSize,
+    const std::function<void(int, int)>& body
+)
+{
+    if (begin >= end)
+    {
+        return;
+    }
+
+    grainSize = std::max(1, grainSize);
+
+    if (_workers.empty() || tInsideThreadPool || end - begin <= grainSize)
+    {
+        body(begin, end);
+        return;
+    }
+
+    std::lock_guard<std::mutex> submitLock{_submitMutex};
+
+    {
+        // A worker that woke up late for the previous job may still be
+        // draining the exhausted chunk counter; let it leave first.
+        std::unique_lock<std::mutex> lock{_mutex};
+        _jobFinished.wait(lock, [this]() { return _activeWorkers == 0; });
+
+        _body = &body;
+        _begin = begin;
+        _end = end;
+        _grainSize = grainSize;
+        _chunkCount = (end - begin + grainSize - 1) / grainSize;
+        _nextChunk = 0;
+        ++_generation;
+        ++_activeWorkers;
+    }
+
+    _jobAvailable.notify_all();
+    runChunks();
+
+    std::unique_lock<std::mutex> lock{_mutex};
+    --_activeWorkers;
+    _jobFinished.wait(lock, [this]() { return _activeWorkers == 0; });
+    _body = nullptr;
+}
+
+void ThreadPool::workerLoop()
+{
+    tInsideThreadPool = true;
+    unsigned long seenGeneration = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock{_mutex};
+            _jobAvailable.wait(lock, [&]() {
+                return _stopping || _generation != seenGeneration;
+            });
+
+            if (_stopping)
+            {
+                return;
+            }
+
+            seenGeneration = _generation;
+            ++_activeWorkers;
+        }
+
+        runChunks();
+
+        {
+            std::lock_guard<std::mutex> lock{_mutex};
+            --_activeWorkers;
+        }
+
+        _jobFinished.notify_all();
+    }
+}
+
+void ThreadPool::runChunks()
+{
+    auto wasInside = tInsideThreadPool;
+    tInsideThreadPool = true;
+
+    while (true)
+    {
+        auto chunk = _nextChunk.fetch_add(1);
+        if (chunk >= _chunkCount)
+        {
+            break;
+        }
+
+        auto first = _begin + chunk * _grainSize;
+        auto last = std::min(_end, first + _grainSize);
+        (*_body)(first, last);
+    }
+
+    tInsideThreadPool = wasInside;
+}
+
+}
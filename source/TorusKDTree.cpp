@@ -0,0 +1,193 @@
+#include "TorusKDTree.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "glm/gtc/constants.hpp"
+
+namespace kinematic
+{
+
+namespace
+{
+    float getAngleDistance(float a, float b)
+    {
+        auto distance = std::abs(a - b);
+        return std::min(distance, glm::two_pi<float>() - distance);
+    }
+}
+
+TorusKDTree::TorusKDTree():
+    _dimension{0}
+{
+}
+
+TorusKDTree::~TorusKDTree()
+{
+}
+
+void TorusKDTree::reset(int dimension)
+{
+    _dimension = dimension;
+    _points.clear();
+    _nodes.clear();
+}
+
+int TorusKDTree::getDimension() const
+{
+    return _dimension;
+}
+
+int TorusKDTree::size() const
+{
+    return static_cast<int>(_nodes.size());
+}
+
+int TorusKDTree::insert(const float* point)
+{
+    auto index = size();
+    _points.insert(std::end(_points), point, point + _dimension);
+    _nodes.push_back({-1, -1});
+
+    if (index == 0)
+    {
+        return index;
+    }
+
+    auto node = 0;
+    for (auto depth = 0; ; ++depth)
+    {
+        auto axis = depth % _dimension;
+        auto& next = point[axis] < getPoint(node)[axis]
+            ? _nodes[node].left
+            : _nodes[node].right;
+
+        if (next < 0)
+        {
+            next = index;
+            return index;
+        }
+
+        node = next;
+    }
+}
+
+const float* TorusKDTree::getPoint(int index) const
+{
+    return &_points[static_cast<size_t>(index) * _dimension];
+}
+
+int TorusKDTree::findNearest(const float* query)
+{
+    findNearest(query, 1, _nearest);
+    return _nearest.empty() ? -1 : _nearest[0];
+}
+
+void TorusKDTree::findNearest(
+    const float* query,
+    int count,
+    std::vector<int>& indices
+)
+{
+    indices.clear();
+    if (size() == 0 || count <= 0)
+    {
+        return;
+    }
+
+    _low.assign(_dimension, 0.0f);
+    _high.assign(_dimension, glm::two_pi<float>());
+    _best.clear();
+
+    search(0, 0, query, 0.0f, count);
+
+    std::sort_heap(std::begin(_best), std::end(_best));
+    for (const auto& candidate: _best)
+    {
+        indices.push_back(candidate.index);
+    }
+}
+
+float TorusKDTree::getDistance(const float* a, const float* b) const
+{
+    float distance = 0.0f;
+    for (auto axis = 0; axis < _dimension; ++axis)
+    {
+        distance += getAngleDistance(a[axis], b[axis]);
+    }
+
+    return distance;
+}
+
+float TorusKDTree::getAxisDistance(float value, float low, float high) const
+{
+    if (value >= low && value <= high)
+    {
+        return 0.0f;
+    }
+
+    return std::min(
+        getAngleDistance(value, low),
+        getAngleDistance(value, high)
+    );
+}
+
+void TorusKDTree::search(
+    int node,
+    int depth,
+    const float* query,
+    float bound,
+    int count
+)
+{
+    auto full = static_cast<int>(_best.size()) == count;
+    if (full && bound >= _best.front().distance)
+    {
+        return;
+    }
+
+    auto point = getPoint(node);
+    auto distance = getDistance(query, point);
+
+    if (static_cast<int>(_best.size()) < count)
+    {
+        _best.push_back({distance, node});
+        std::push_heap(std::begin(_best), std::end(_best));
+    }
+    else if (distance < _best.front().distance)
+    {
+        std::pop_heap(std::begin(_best), std::end(_best));
+        _best.back() = {distance, node};
+        std::push_heap(std::begin(_best), std::end(_best));
+    }
+
+    auto axis = depth % _dimension;
+    auto split = point[axis];
+    bool queryLeft = query[axis] < split;
+
+    // The side holding the query first, then the other one with the bound
+    // tightened by how far the query sits from that side's slab.
+    for (auto pass = 0; pass < 2; ++pass)
+    {
+        bool left = (pass == 0) == queryLeft;
+        auto child = left ? _nodes[node].left : _nodes[node].right;
+        if (child < 0)
+        {
+            continue;
+        }
+
+        auto savedLow = _low[axis], savedHigh = _high[axis];
+        if (left) { _high[axis] = split; } else { _low[axis] = split; }
+
+        auto childBound = bound
+            - getAxisDistance(query[axis], savedLow, savedHigh)
+            + getAxisDistance(query[axis], _low[axis], _high[axis]);
+
+        search(child, depth + 1, query, childBound, count);
+
+        _low[axis] = savedLow;
+        _high[axis] = savedHigh;
+    }
+}
+
+}
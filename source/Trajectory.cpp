@@ -0,0 +1,368 @@
+#include "Trajectory.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "ChainConfigurationSpace.hpp"
+#include "PathSmoother.hpp"
+
+namespace kinematic
+{
+
+namespace
+{
+    const int cBisectionSteps = 32;
+}
+
+const float Trajectory::cDefaultVelocityLimit = 1.5f;
+const float Trajectory::cDefaultAccelerationLimit = 4.0f;
+const float Trajectory::cDefaultGridStep = 0.02f;
+
+Trajectory::Trajectory():
+    _gridStep{cDefaultGridStep},
+    _dimension{0}
+{
+}
+
+Trajectory::~Trajectory()
+{
+}
+
+void Trajectory::setVelocityLimits(const JointVector& velocityLimits)
+{
+    _velocityLimits = velocityLimits;
+}
+
+const JointVector& Trajectory::getVelocityLimits() const
+{
+    return _velocityLimits;
+}
+
+void Trajectory::setAccelerationLimits(const JointVector& accelerationLimits)
+{
+    _accelerationLimits = accelerationLimits;
+}
+
+const JointVector& Trajectory::getAccelerationLimits() const
+{
+    return _accelerationLimits;
+}
+
+void Trajectory::setGridStep(float gridStep)
+{
+    _gridStep = gridStep;
+}
+
+float Trajectory::getGridStep() const
+{
+    return _gridStep;
+}
+
+void Trajectory::create(const std::vector<JointVector>& path)
+{
+    clear();
+
+    if (path.empty())
+    {
+        return;
+    }
+
+    _dimension = static_cast<int>(path.front().size());
+    _jointVelocityLimits.resize(_dimension);
+    _jointAccelerationLimits.resize(_dimension);
+
+    for (auto joint = 0; joint < _dimension; ++joint)
+    {
+        _jointVelocityLimits[joint] =
+            joint < static_cast<int>(_velocityLimits.size())
+                ? _velocityLimits[joint]
+                : cDefaultVelocityLimit;
+        _jointAccelerationLimits[joint] =
+            joint < static_cast<int>(_accelerationLimits.size())
+                ? _accelerationLimits[joint]
+                : cDefaultAccelerationLimit;
+    }
+
+    // Pieces are measured by the Euclidean joint travel; repeated
+    // configurations would make empty pieces, so they are dropped.
+    std::vector<float> directions;
+    for (const auto& point: PathSmoother::resample(path, _gridStep))
+    {
+        if (!_points.empty())
+        {
+            JointVector delta(_dimension);
+            float length = 0.0f;
+
+            for (auto joint = 0; joint < _dimension; ++joint)
+            {
+                delta[joint] = ChainConfigurationSpace::getAngleDifference(
+                    _points.back()[joint],
+                    point[joint]
+                );
+                length += delta[joint] * delta[joint];
+            }
+
+            length = std::sqrt(length);
+            if (length <= 0.0f)
+            {
+                continue;
+            }
+
+            for (auto joint = 0; joint < _dimension; ++joint)
+            {
+                directions.push_back(delta[joint] / length);
+            }
+
+            _lengths.push_back(length);
+        }
+
+        _points.push_back(point);
+    }
+
+    auto pointCount = static_cast<int>(_points.size());
+    _firstDerivatives.assign(pointCount * _dimension, 0.0f);
+    _secondDerivatives.assign(pointCount * _dimension, 0.0f);
+
+    for (auto point = 0; point < pointCount && pointCount > 1; ++point)
+    {
+        auto before = std::max(0, point - 1);
+        auto after = std::min(pointCount - 2, point);
+
+        for (auto joint = 0; joint < _dimension; ++joint)
+        {
+            auto incoming = directions[before * _dimension + joint];
+            auto outgoing = directions[after * _dimension + joint];
+            auto index = point * _dimension + joint;
+
+            _firstDerivatives[index] = 0.5f * (incoming + outgoing);
+            if (before != after)
+            {
+                _secondDerivatives[index] = (outgoing - incoming)
+                    / (0.5f * (_lengths[before] + _lengths[after]));
+            }
+        }
+    }
+
+    // Backward pass: the largest squared speed at every point from which
+    // the end can still be reached at rest.
+    std::vector<float> reachable(pointCount, 0.0f);
+    for (auto point = pointCount - 2; point >= 0; --point)
+    {
+        reachable[point] = getBackwardSquaredSpeed(point, reachable[point + 1]);
+    }
+
+    // Forward pass: accelerate as hard as possible below that bound.
+    std::vector<float> squaredSpeeds(pointCount, 0.0f);
+    _accelerations.assign(std::max(0, pointCount - 1), 0.0f);
+
+    for (auto point = 0; point + 1 < pointCount; ++point)
+    {
+        float lowest, highest;
+        getAccelerationRange(point, squaredSpeeds[point], lowest, highest);
+
+        auto next = squaredSpeeds[point] + 2.0f * _lengths[point] * highest;
+        squaredSpeeds[point + 1] = std::max(
+            0.0f,
+            std::min(reachable[point + 1], next)
+        );
+
+        _accelerations[point] =
+            (squaredSpeeds[point + 1] - squaredSpeeds[point])
+                / (2.0f * _lengths[point]);
+    }
+
+    _speeds.resize(pointCount);
+    _times.resize(pointCount);
+    _times[0] = 0.0f;
+
+    for (auto point = 0; point < pointCount; ++point)
+    {
+        _speeds[point] = std::sqrt(squaredSpeeds[point]);
+
+        if (point > 0)
+        {
+            auto meanSpeed = 0.5f * (_speeds[point - 1] + _speeds[point]);
+            _times[point] = _times[point - 1] + _lengths[point - 1]
+                / std::max(meanSpeed, std::numeric_limits<float>::min());
+        }
+    }
+}
+
+void Trajectory::clear()
+{
+    _dimension = 0;
+    _points.clear();
+    _lengths.clear();
+    _firstDerivatives.clear();
+    _secondDerivatives.clear();
+    _speeds.clear();
+    _accelerations.clear();
+    _times.clear();
+}
+
+bool Trajectory::isEmpty() const
+{
+    return _points.empty();
+}
+
+float Trajectory::getDuration() const
+{
+    return _times.empty() ? 0.0f : _times.back();
+}
+
+void Trajectory::sample(float time, JointVector& angles) const
+{
+    angles.resize(_dimension);
+
+    if (_points.size() < 2)
+    {
+        if (!_points.empty())
+        {
+            angles = _points.front();
+        }
+
+        return;
+    }
+
+    time = std::max(0.0f, std::min(time, getDuration()));
+
+    auto piece = static_cast<int>(
+        std::upper_bound(_times.begin(), _times.end(), time)
+            - _times.begin()
+    ) - 1;
+    piece = std::max(0, std::min(piece, static_cast<int>(_lengths.size()) - 1));
+
+    auto elapsed = time - _times[piece];
+    auto travel = _speeds[piece] * elapsed
+        + 0.5f * _accelerations[piece] * elapsed * elapsed;
+    auto fraction = std::max(0.0f, std::min(1.0f, travel / _lengths[piece]));
+
+    const auto& from = _points[piece];
+    const auto& to = _points[piece + 1];
+
+    for (auto joint = 0; joint < _dimension; ++joint)
+    {
+        angles[joint] = ChainConfigurationSpace::wrapAngle(from[joint]
+            + fraction * ChainConfigurationSpace::getAngleDifference(
+                from[joint],
+                to[joint]
+            ));
+    }
+}
+
+bool Trajectory::getAccelerationRange(
+    int point,
+    float squaredSpeed,
+    float& lowest,
+    float& highest
+) const
+{
+    // Joint acceleration is q' s'' + q'' s'^2, where s is the path position.
+    // Each joint limit bounds s'' to an interval for a given s'^2.
+    lowest = -std::numeric_limits<float>::infinity();
+    highest = std::numeric_limits<float>::infinity();
+
+    for (auto joint = 0; joint < _dimension; ++joint)
+    {
+        auto index = point * _dimension + joint;
+        auto first = _firstDerivatives[index];
+        auto centripetal = _secondDerivatives[index] * squaredSpeed;
+        auto limit = _jointAccelerationLimits[joint];
+
+        if (std::abs(first) < 1e-6f)
+        {
+            if (std::abs(centripetal) > limit)
+            {
+                return false;
+            }
+
+            continue;
+        }
+
+        auto bound1 = (-limit - centripetal) / first;
+        auto bound2 = (limit - centripetal) / first;
+        lowest = std::max(lowest, std::min(bound1, bound2));
+        highest = std::min(highest, std::max(bound1, bound2));
+    }
+
+    return lowest <= highest;
+}
+
+float Trajectory::getMaxSquaredSpeed(int point) const
+{
+    auto maxSquaredSpeed = std::numeric_limits<float>::max();
+    for (auto joint = 0; joint < _dimension; ++joint)
+    {
+        auto first = std::abs(_firstDerivatives[point * _dimension + joint]);
+        if (first > 1e-6f)
+        {
+            auto speed = _jointVelocityLimits[joint] / first;
+            maxSquaredSpeed = std::min(maxSquaredSpeed, speed * speed);
+        }
+    }
+
+    // The speeds for which the acceleration limits can be met form an
+    // interval starting at rest.
+    float lowest, highest;
+    if (getAccelerationRange(point, maxSquaredSpeed, lowest, highest))
+    {
+        return maxSquaredSpeed;
+    }
+
+    float feasible = 0.0f, infeasible = maxSquaredSpeed;
+    for (auto step = 0; step < cBisectionSteps; ++step)
+    {
+        auto middle = 0.5f * (feasible + infeasible);
+        if (getAccelerationRange(point, middle, lowest, highest))
+        {
+            feasible = middle;
+        }
+        else
+        {
+            infeasible = middle;
+        }
+    }
+
+    return feasible;
+}
+
+float Trajectory::getBackwardSquaredSpeed(
+    int point,
+    float nextSquaredSpeed
+) const
+{
+    // Largest squared speed here that can brake to at most the next bound
+    // over this piece. Such speeds again form an interval starting at rest.
+    auto length = _lengths[point];
+    auto canBrake = [&](float squaredSpeed)
+    {
+        float lowest, highest;
+        return getAccelerationRange(point, squaredSpeed, lowest, highest)
+            && squaredSpeed + 2.0f * length * lowest <= nextSquaredSpeed;
+    };
+
+    auto maxSquaredSpeed = getMaxSquaredSpeed(point);
+    if (canBrake(maxSquaredSpeed))
+    {
+        return maxSquaredSpeed;
+    }
+
+    float feasible = 0.0f, infeasible = maxSquaredSpeed;
+    for (auto step = 0; step < cBisectionSteps; ++step)
+    {
+        auto middle = 0.5f * (feasible + infeasible);
+        if (canBrake(middle))
+        {
+            feasible = middle;
+        }
+        else
+        {
+            infeasible = middle;
+        }
+    }
+
+    return feasible;
+}
+
+}
@@ -0,0 +1,37 @@
+#include "TrigonometryTable.hpp"
+
+#include <cmath>
+
+namespace kinematic
+{
+
+TrigonometryTable::TrigonometryTable():
+    _resolution{0}
+{
+}
+
+TrigonometryTable::~TrigonometryTable()
+{
+}
+
+void TrigonometryTable::create(int resolution)
+{
+    _resolution = resolution;
+    _cosines.resize(resolution);
+    _sines.resize(resolution);
+
+    const double cTwoPi = 6.283185307179586476925;
+    for (auto step = 0; step < resolution; ++step)
+    {
+        auto angle = cTwoPi * step / resolution;
+        _cosines[step] = static_cast<float>(std::cos(angle));
+        _sines[step] = static_cast<float>(std::sin(angle));
+    }
+}
+
+int TrigonometryTable::getResolution() const
+{
+    return _resolution;
+}
+
+}
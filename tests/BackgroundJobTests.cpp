@@ -0,0 +1,139 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "BackgroundJob.hpp"
+#include "Tests.hpp"
+
+namespace kinematic
+{
+namespace test
+{
+
+namespace
+{
+    // Polls until the job's thread is done, giving up after a few seconds
+    // so that a job that never winds down fails instead of hanging.
+    bool waitForJob(BackgroundJob& job, int& finishedPolls)
+    {
+        auto deadline = std::chrono::steady_clock::now()
+            + std::chrono::seconds{5};
+
+        while (job.isRunning())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                return false;
+            }
+
+            finishedPolls += job.poll() ? 1 : 0;
+            std::this_thread::yield();
+        }
+
+        return true;
+    }
+
+    // Work runs until it sees the cancellation, after which the job winds
+    // down without running its finishing step. A completed job runs it
+    // exactly once.
+    void testJobCancellation()
+    {
+        BackgroundJob job;
+        std::atomic<bool> started{false};
+        auto finishes = 0, finishedPolls = 0;
+
+        job.start(
+            [&](JobProgress& progress)
+            {
+                started = true;
+                while (!progress.isCancelled())
+                {
+                    std::this_thread::yield();
+                }
+
+                return true;
+            },
+            [&]() { ++finishes; }
+        );
+
+        while (!started)
+        {
+            std::this_thread::yield();
+        }
+
+        KINEMATIC_CHECK(job.isRunning());
+        KINEMATIC_CHECK(!job.poll());
+
+        job.cancel();
+        KINEMATIC_CHECK(job.isCancelled());
+        KINEMATIC_CHECK(waitForJob(job, finishedPolls));
+        KINEMATIC_CHECK(finishes == 0 && finishedPolls == 0);
+
+        job.start(
+            [](JobProgress& progress)
+            {
+                progress.setProgress(1.0f);
+                return true;
+            },
+            [&]() { ++finishes; }
+        );
+
+        KINEMATIC_CHECK(!job.isCancelled());
+        KINEMATIC_CHECK(waitForJob(job, finishedPolls));
+        KINEMATIC_CHECK(finishes == 1 && finishedPolls == 1);
+        KINEMATIC_CHECK(job.getProgress() == 1.0f);
+        KINEMATIC_CHECK(!job.poll());
+    }
+
+    TestRegistration gJobCancellation{
+        "job-cancellation",
+        testJobCancellation
+    };
+
+    // Starting new work cancels and joins the running one first, so the
+    // old finishing step never runs and the old work is over by the time
+    // start returns. Destroying a job does the same.
+    void testJobReplacement()
+    {
+        std::atomic<int> running{0};
+        auto finishes = 0, finishedPolls = 0;
+
+        auto spin = [&](JobProgress& progress)
+        {
+            ++running;
+            while (!progress.isCancelled())
+            {
+                std::this_thread::yield();
+            }
+
+            --running;
+            return true;
+        };
+
+        {
+            BackgroundJob job;
+            job.start(spin, [&]() { finishes += 10; });
+
+            job.start(
+                [&](JobProgress&)
+                {
+                    return running == 0;
+                },
+                [&]() { ++finishes; }
+            );
+
+            KINEMATIC_CHECK(waitForJob(job, finishedPolls));
+            KINEMATIC_CHECK(finishes == 1 && finishedPolls == 1);
+
+            job.start(spin, [&]() { finishes += 10; });
+        }
+
+        KINEMATIC_CHECK(running == 0);
+        KINEMATIC_CHECK(finishes == 1);
+    }
+
+    TestRegistration gJobReplacement{"job-replacement", testJobReplacement};
+}
+
+}
+}
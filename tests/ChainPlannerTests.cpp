@@ -0,0 +1,286 @@
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "ChainConfigurationSpace.hpp"
+#include "LatticePlanner.hpp"
+#include "LazyPRMPlanner.hpp"
+#include "PathSmoother.hpp"
+#include "RRTConnectPlanner.hpp"
+#include "Tests.hpp"
+
+namespace kinematic
+{
+namespace test
+{
+
+namespace
+{
+    // Much finer than the planners' own checks: the tip of the test chain
+    // moves about 0.002 per step.
+    const float cReferenceStep = 0.0005f;
+
+    bool isMotionFree(
+        const ChainConfigurationSpace& space,
+        const JointVector& from,
+        const JointVector& to
+    )
+    {
+        auto dimension = space.getDimension();
+        JointVector delta(dimension), current(dimension);
+
+        float longest = 0.0f;
+        for (auto joint = 0; joint < dimension; ++joint)
+        {
+            delta[joint] = ChainConfigurationSpace::getAngleDifference(
+                from[joint],
+                to[joint]
+            );
+            longest = std::max(longest, std::abs(delta[joint]));
+        }
+
+        auto steps = static_cast<int>(std::ceil(longest / cReferenceStep));
+        for (auto step = 0; step <= steps; ++step)
+        {
+            auto t = steps > 0 ? static_cast<float>(step) / steps : 0.0f;
+            for (auto joint = 0; joint < dimension; ++joint)
+            {
+                current[joint] = from[joint] + t * delta[joint];
+            }
+
+            if (!space.checkConfiguration(current))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool isPathValid(
+        const ChainConfigurationSpace& space,
+        const std::vector<JointVector>& path,
+        const JointVector& start,
+        const JointVector& goal
+    )
+    {
+        const float cTolerance = 1e-4f;
+        if (path.empty()
+            || space.getDistance(path.front(), start) > cTolerance
+            || space.getDistance(path.back(), goal) > cTolerance)
+        {
+            return false;
+        }
+
+        for (auto i = 1u; i < path.size(); ++i)
+        {
+            if (!isMotionFree(space, path[i - 1], path[i]))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    float getPathLength(
+        const ChainConfigurationSpace& space,
+        const std::vector<JointVector>& path
+    )
+    {
+        float length = 0.0f;
+        for (auto i = 1u; i < path.size(); ++i)
+        {
+            length += space.getDistance(path[i - 1], path[i]);
+        }
+
+        return length;
+    }
+
+    JointVector getRandomFreePose(
+        const ChainConfigurationSpace& space,
+        std::mt19937& random
+    )
+    {
+        std::uniform_real_distribution<float> angle(-3.14f, 3.14f);
+
+        JointVector pose(space.getDimension());
+        do
+        {
+            for (auto& value: pose)
+            {
+                value = angle(random);
+            }
+        }
+        while (!space.checkConfiguration(pose));
+
+        return pose;
+    }
+
+    // Plans between random poses of a three-link chain among thin boxes,
+    // which catch moves that are only checked at coarse steps, and checks
+    // that no configuration along a found path, smoothed too if a smoother
+    // is given, touches a box. Returns how many queries found a path.
+    int checkPlannedPaths(ChainPlanner& planner, PathSmoother* smoother)
+    {
+        std::mt19937 random{7};
+        std::uniform_real_distribution<float> position(-2.0f, 2.0f);
+        std::uniform_real_distribution<float> length(0.2f, 0.5f);
+
+        auto obstacles = std::make_shared<ConfigurationSpace>();
+        for (auto i = 0; i < 8; ++i)
+        {
+            glm::vec2 centre{position(random), position(random)};
+            glm::vec2 half = random() % 2 == 0
+                ? glm::vec2{0.5f * length(random), 0.01f}
+                : glm::vec2{0.01f, 0.5f * length(random)};
+            obstacles->addConstraint({centre - half, centre + half});
+        }
+
+        KinematicChain chain;
+        chain.setLinkLengths({1.0f, 0.8f, 0.6f});
+
+        ChainConfigurationSpace space;
+        space.setChain(chain);
+        space.setObstacles(obstacles);
+
+        auto foundPaths = 0;
+        for (auto query = 0; query < 10; ++query)
+        {
+            auto start = getRandomFreePose(space, random);
+            auto goal = getRandomFreePose(space, random);
+
+            if (!planner.findPath(space, start, goal))
+            {
+                continue;
+            }
+
+            ++foundPaths;
+            auto path = planner.getPath();
+            KINEMATIC_CHECK(isPathValid(space, path, start, goal));
+
+            if (smoother != nullptr)
+            {
+                auto length = getPathLength(space, path);
+                smoother->smooth(space, path);
+                KINEMATIC_CHECK(isPathValid(space, path, start, goal));
+                KINEMATIC_CHECK(
+                    getPathLength(space, path) <= length + 1e-3f
+                );
+            }
+        }
+
+        return foundPaths;
+    }
+
+    void testLatticePlanner()
+    {
+        LatticePlanner planner;
+        KINEMATIC_CHECK(checkPlannedPaths(planner, nullptr) > 0);
+    }
+
+    TestRegistration gLatticePlanner{"lattice-planner", testLatticePlanner};
+
+    void testSamplingPlanners()
+    {
+        RRTConnectPlanner rrtConnect;
+        KINEMATIC_CHECK(checkPlannedPaths(rrtConnect, nullptr) > 0);
+
+        LazyPRMPlanner lazyRoadmap;
+        KINEMATIC_CHECK(checkPlannedPaths(lazyRoadmap, nullptr) > 0);
+    }
+
+    TestRegistration gSamplingPlanners{
+        "sampling-planners",
+        testSamplingPlanners
+    };
+
+    // The lazy roadmap keeps collision results between queries; a box
+    // dropped onto the middle of a found path must not be missed by the
+    // same query repeated afterwards.
+    void testRoadmapReuse()
+    {
+        std::mt19937 random{3};
+
+        auto obstacles = std::make_shared<ConfigurationSpace>();
+        obstacles->addConstraint({{1.2f, 0.4f}, {1.3f, 1.4f}});
+
+        KinematicChain chain;
+        chain.setLinkLengths({1.0f, 0.8f, 0.6f});
+
+        ChainConfigurationSpace space;
+        space.setChain(chain);
+        space.setObstacles(obstacles);
+
+        LazyPRMPlanner planner;
+        auto start = getRandomFreePose(space, random);
+        auto goal = getRandomFreePose(space, random);
+        KINEMATIC_CHECK(planner.findPath(space, start, goal));
+
+        auto path = planner.getPath();
+        KINEMATIC_CHECK(path.size() > 2);
+
+        std::vector<glm::vec2> positions(chain.getJointCount() + 1);
+        chain.computeJointPositions(
+            path[path.size() / 2].data(),
+            positions.data()
+        );
+        glm::vec2 tip = positions.back(), half{0.02f, 0.02f};
+        obstacles->addConstraint({tip - half, tip + half});
+
+        if (planner.findPath(space, start, goal))
+        {
+            KINEMATIC_CHECK(isPathValid(space, planner.getPath(), start, goal));
+        }
+    }
+
+    TestRegistration gRoadmapReuse{"roadmap-reuse", testRoadmapReuse};
+
+    void testPathSmoother()
+    {
+        RRTConnectPlanner planner;
+        PathSmoother smoother;
+        KINEMATIC_CHECK(checkPlannedPaths(planner, &smoother) > 0);
+
+        // Resampling keeps the ends, splits moves across the wrap the short
+        // way and never turns a joint by more than the step.
+        const float cMaxStep = 0.05f;
+        std::vector<JointVector> path{
+            {0.0f, 3.0f},
+            {1.0f, -3.0f},
+            {1.0f, -3.0f},
+            {-0.3f, 2.5f}
+        };
+        auto resampled = PathSmoother::resample(path, cMaxStep);
+
+        KINEMATIC_CHECK(resampled.size() > path.size());
+        KINEMATIC_CHECK(resampled.front() == path.front());
+        for (auto i = 1u; i < resampled.size(); ++i)
+        {
+            for (auto joint = 0; joint < 2; ++joint)
+            {
+                auto step = ChainConfigurationSpace::getAngleDifference(
+                    resampled[i - 1][joint],
+                    resampled[i][joint]
+                );
+                KINEMATIC_CHECK(std::abs(step) <= cMaxStep + 1e-5f);
+            }
+        }
+
+        for (auto joint = 0; joint < 2; ++joint)
+        {
+            auto error = ChainConfigurationSpace::getAngleDifference(
+                resampled.back()[joint],
+                path.back()[joint]
+            );
+            KINEMATIC_CHECK(std::abs(error) < 1e-5f);
+        }
+    }
+
+    TestRegistration gPathSmoother{"path-smoother", testPathSmoother};
+}
+
+}
+}
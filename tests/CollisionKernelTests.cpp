@@ -0,0 +1,146 @@
+#include <random>
+#include <vector>
+
+#include "CollisionKernels.hpp"
+#include "Tests.hpp"
+
+namespace kinematic
+{
+namespace test
+{
+
+namespace
+{
+    // Coordinates on a 1/256 grid keep every step of the separating axis
+    // test exact, so the vector and scalar paths must agree on touching
+    // cases too.
+    float getGridCoordinate(std::mt19937& random)
+    {
+        std::uniform_int_distribution<int> steps(-256, 256);
+        return steps(random) / 256.0f;
+    }
+
+    fw::AABB<glm::vec2> getRandomBox(std::mt19937& random)
+    {
+        glm::vec2 first{getGridCoordinate(random), getGridCoordinate(random)};
+        glm::vec2 second{getGridCoordinate(random), getGridCoordinate(random)};
+        return {glm::min(first, second), glm::max(first, second)};
+    }
+
+    fw::AABB<glm::vec2> grow(const fw::AABB<glm::vec2>& box, float margin)
+    {
+        return {box.min - glm::vec2{margin}, box.max + glm::vec2{margin}};
+    }
+
+    // Batches of every size up to a few vectors, so both full vectors and
+    // the scalar tail are covered, against one box at a time.
+    void testAABBBatch()
+    {
+        std::mt19937 random{3};
+        const float margins[] = {0.0f, 0.0625f};
+
+        auto mismatches = 0, hits = 0;
+        for (auto count = 0; count <= 3 * AABBBatch::cLaneCount + 1; ++count)
+        {
+            std::vector<fw::AABB<glm::vec2>> boxes;
+            for (auto i = 0; i < count; ++i)
+            {
+                boxes.push_back(getRandomBox(random));
+            }
+
+            AABBBatch batch;
+            batch.assign(boxes);
+            KINEMATIC_CHECK(batch.size() == count);
+
+            for (auto query = 0; query < 200; ++query)
+            {
+                glm::vec2 start{
+                    getGridCoordinate(random),
+                    getGridCoordinate(random)
+                };
+                glm::vec2 end{
+                    getGridCoordinate(random),
+                    getGridCoordinate(random)
+                };
+
+                for (auto margin: margins)
+                {
+                    auto expected = false;
+                    for (const auto& box: boxes)
+                    {
+                        expected = expected
+                            || intersectSegmentAABB(
+                                start,
+                                end,
+                                grow(box, margin)
+                            );
+                    }
+
+                    auto found = batch.intersectsSegment(start, end, margin);
+                    mismatches += found != expected;
+                    hits += found;
+                }
+            }
+        }
+
+        KINEMATIC_CHECK(mismatches == 0);
+        KINEMATIC_CHECK(hits > 0);
+    }
+
+    void testSegmentsAgainstAABB()
+    {
+        std::mt19937 random{4};
+
+        auto mismatches = 0, hits = 0;
+        for (auto count = 0; count <= 3 * AABBBatch::cLaneCount + 1; ++count)
+        {
+            std::vector<float> startX, startY, endX, endY;
+            for (auto i = 0; i < count; ++i)
+            {
+                startX.push_back(getGridCoordinate(random));
+                startY.push_back(getGridCoordinate(random));
+                endX.push_back(getGridCoordinate(random));
+                endY.push_back(getGridCoordinate(random));
+            }
+
+            for (auto query = 0; query < 50; ++query)
+            {
+                auto box = getRandomBox(random);
+                std::vector<unsigned char> collisions(count, 0);
+                collideSegmentsWithAABB(
+                    startX.data(),
+                    startY.data(),
+                    endX.data(),
+                    endY.data(),
+                    count,
+                    box,
+                    collisions.data()
+                );
+
+                for (auto i = 0; i < count; ++i)
+                {
+                    auto expected = intersectSegmentAABB(
+                        {startX[i], startY[i]},
+                        {endX[i], endY[i]},
+                        box
+                    );
+
+                    mismatches += (collisions[i] != 0) != expected;
+                    hits += expected;
+                }
+            }
+        }
+
+        KINEMATIC_CHECK(mismatches == 0);
+        KINEMATIC_CHECK(hits > 0);
+    }
+
+    TestRegistration gAABBBatch{"aabb-batch", testAABBBatch};
+    TestRegistration gSegmentsAgainstAABB{
+        "segments-against-aabb",
+        testSegmentsAgainstAABB
+    };
+}
+
+}
+}
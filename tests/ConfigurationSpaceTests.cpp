@@ -0,0 +1,143 @@
+#include <random>
+#include <vector>
+
+#include "ConfigurationSpace.hpp"
+#include "Tests.hpp"
+
+namespace kinematic
+{
+namespace test
+{
+
+namespace
+{
+    fw::AABB<glm::vec2> getRandomBox(std::mt19937& random)
+    {
+        std::uniform_real_distribution<float> position(-0.6f, 0.6f);
+        std::uniform_real_distribution<float> extent(0.01f, 0.08f);
+
+        glm::vec2 centre{position(random), position(random)};
+        glm::vec2 half{extent(random), extent(random)};
+        return {centre - half, centre + half};
+    }
+
+    int countDifferences(
+        const ConfigurationSpace& first,
+        const ConfigurationSpace& second
+    )
+    {
+        auto resolution = first.getResolution();
+        auto differences = 0;
+        for (auto alpha = 0; alpha < resolution; ++alpha)
+        {
+            for (auto beta = 0; beta < resolution; ++beta)
+            {
+                differences += first.verifyAvailability({alpha, beta})
+                    != second.verifyAvailability({alpha, beta});
+            }
+        }
+
+        return differences;
+    }
+
+    // Constraints added, moved and removed one at a time on a built map leave
+    // it equal to a map built from scratch.
+    void testIncrementalMap()
+    {
+        std::mt19937 random{11};
+
+        ConfigurationSpace space;
+        for (auto i = 0; i < 10; ++i)
+        {
+            space.addConstraint(getRandomBox(random));
+        }
+
+        space.createAvailabilityMap();
+
+        for (auto edit = 0; edit < 60; ++edit)
+        {
+            auto count = static_cast<int>(space.getConstraints().size());
+            auto kind = random() % 3;
+
+            if (kind == 0 || count < 2)
+            {
+                space.addConstraint(getRandomBox(random));
+            }
+            else if (kind == 1)
+            {
+                space.removeConstraint(random() % count);
+            }
+            else
+            {
+                space.setConstraint(random() % count, getRandomBox(random));
+            }
+
+            KINEMATIC_CHECK(space.isAvailabilityMapCreated());
+        }
+
+        ConfigurationSpace rebuilt;
+        rebuilt.setConstraints(space.getConstraints());
+        rebuilt.createAvailabilityMap();
+
+        KINEMATIC_CHECK(rebuilt.getOccupancyGrid().countOccupied() > 0);
+        KINEMATIC_CHECK(countDifferences(space, rebuilt) == 0);
+        KINEMATIC_CHECK(
+            space.getOccupancyGrid().countOccupied()
+                == rebuilt.getOccupancyGrid().countOccupied()
+        );
+    }
+
+    // A free cell stands for every pose within half a step of its angles, so
+    // poses sampled anywhere inside it must be free.
+    void testConservativeMap()
+    {
+        std::mt19937 random{5};
+
+        ConfigurationSpace space;
+        for (auto i = 0; i < 20; ++i)
+        {
+            space.addConstraint(getRandomBox(random));
+        }
+
+        space.createAvailabilityMap();
+
+        auto resolution = space.getResolution();
+        auto halfStep = 0.5f * (space.getCellAngle(1) - space.getCellAngle(0));
+        std::uniform_real_distribution<float> offset(-halfStep, halfStep);
+
+        auto freeCells = 0, collisions = 0;
+        for (auto alpha = 0; alpha < resolution; ++alpha)
+        {
+            for (auto beta = 0; beta < resolution; ++beta)
+            {
+                if (!space.verifyAvailability({alpha, beta}))
+                {
+                    continue;
+                }
+
+                ++freeCells;
+                auto angles = space.getCellAngles({alpha, beta});
+                for (auto sample = 0; sample < 4; ++sample)
+                {
+                    collisions += !space.checkConfiguration(
+                        angles.x + offset(random),
+                        angles.y + offset(random)
+                    );
+                }
+            }
+        }
+
+        KINEMATIC_CHECK(freeCells > 0);
+        KINEMATIC_CHECK(freeCells < resolution * resolution);
+        KINEMATIC_CHECK(collisions == 0);
+    }
+
+    TestRegistration gIncrementalMap{"incremental-map", testIncrementalMap};
+    TestRegistration gConservativeMap{
+        "conservative-map",
+        testConservativeMap
+    };
+}
+
+}
+}
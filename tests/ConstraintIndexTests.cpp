@@ -0,0 +1,171 @@
+#include <random>
+#include <vector>
+
+#include "CollisionKernels.hpp"
+#include "ConstraintIndex.hpp"
+#include "Tests.hpp"
+
+namespace kinematic
+{
+namespace test
+{
+
+namespace
+{
+    float getGridCoordinate(std::mt19937& random)
+    {
+        std::uniform_int_distribution<int> steps(-256, 256);
+        return steps(random) / 256.0f;
+    }
+
+    // Mostly small boxes, with the odd one large enough to be kept aside
+    // from the grid.
+    fw::AABB<glm::vec2> getRandomBox(std::mt19937& random)
+    {
+        glm::vec2 centre{getGridCoordinate(random), getGridCoordinate(random)};
+        auto size = random() % 10 == 0 ? 2.0f : 0.125f;
+        glm::vec2 half{
+            size * (1 + random() % 8) / 16.0f,
+            size * (1 + random() % 8) / 16.0f
+        };
+        return {centre - half, centre + half};
+    }
+
+    fw::AABB<glm::vec2> grow(const fw::AABB<glm::vec2>& box, float margin)
+    {
+        return {box.min - glm::vec2{margin}, box.max + glm::vec2{margin}};
+    }
+
+    int findLinear(
+        const std::vector<fw::AABB<glm::vec2>>& boxes,
+        glm::vec2 point
+    )
+    {
+        for (auto i = 0; i < static_cast<int>(boxes.size()); ++i)
+        {
+            if (boxes[i].contains(point))
+            {
+                return i;
+            }
+        }
+
+        return -1;
+    }
+
+    bool intersectsLinear(
+        const std::vector<fw::AABB<glm::vec2>>& boxes,
+        glm::vec2 start,
+        glm::vec2 end,
+        float margin
+    )
+    {
+        for (const auto& box: boxes)
+        {
+            if (intersectSegmentAABB(start, end, grow(box, margin)))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Edits mirrored into a plain vector, removal swapping the last box
+    // into the gap like the owner does, leave point and segment queries
+    // answering exactly like a scan over every box.
+    void testConstraintIndex()
+    {
+        std::mt19937 random{14};
+        const float cellSizes[] = {0.1f, 0.25f};
+        const float margins[] = {0.0f, 0.03f, 0.3f};
+
+        auto mismatches = 0, hits = 0;
+        for (auto cellSize: cellSizes)
+        {
+            ConstraintIndex index;
+            index.setCellSize(cellSize);
+            std::vector<fw::AABB<glm::vec2>> boxes;
+
+            for (auto edit = 0; edit < 200; ++edit)
+            {
+                auto count = static_cast<int>(boxes.size());
+                auto kind = random() % 4;
+
+                if (kind < 2 || count < 3)
+                {
+                    boxes.push_back(getRandomBox(random));
+                    index.add(boxes.back());
+                }
+                else if (kind == 2)
+                {
+                    auto removed = static_cast<int>(random() % count);
+                    boxes[removed] = boxes.back();
+                    boxes.pop_back();
+                    index.remove(removed);
+                }
+                else
+                {
+                    auto moved = static_cast<int>(random() % count);
+                    boxes[moved] = getRandomBox(random);
+                    index.set(moved, boxes[moved]);
+                }
+
+                KINEMATIC_CHECK(index.size() == static_cast<int>(boxes.size()));
+
+                for (auto query = 0; query < 20; ++query)
+                {
+                    glm::vec2 start{
+                        getGridCoordinate(random),
+                        getGridCoordinate(random)
+                    };
+                    glm::vec2 end{
+                        getGridCoordinate(random),
+                        getGridCoordinate(random)
+                    };
+
+                    mismatches += index.findContaining(start)
+                        != findLinear(boxes, start);
+
+                    for (auto margin: margins)
+                    {
+                        auto expected = intersectsLinear(
+                            boxes,
+                            start,
+                            end,
+                            margin
+                        );
+
+                        mismatches += index.intersectsSegment(
+                            start,
+                            end,
+                            margin
+                        ) != expected;
+                        hits += expected;
+                    }
+                }
+            }
+
+            // Rebuilding from the vector must not change any answer either.
+            ConstraintIndex rebuilt;
+            rebuilt.setCellSize(cellSize);
+            rebuilt.assign(boxes);
+            for (auto query = 0; query < 200; ++query)
+            {
+                glm::vec2 point{
+                    getGridCoordinate(random),
+                    getGridCoordinate(random)
+                };
+                mismatches += rebuilt.findContaining(point)
+                    != findLinear(boxes, point);
+            }
+        }
+
+        KINEMATIC_CHECK(mismatches == 0);
+        KINEMATIC_CHECK(hits > 0);
+    }
+
+    TestRegistration gConstraintIndex{"constraint-index", testConstraintIndex};
+}
+
+}
+}
@@ -0,0 +1,245 @@
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "BucketQueue.hpp"
+#include "ConfigurationSpace.hpp"
+#include "CostMap.hpp"
+#include "CostMapPlanner.hpp"
+#include "Tests.hpp"
+
+namespace kinematic
+{
+namespace test
+{
+
+namespace
+{
+    typedef std::pair<int, std::uint32_t> KeyedValue;
+
+    // Keys come out in the same order as from a heap, each value with the
+    // key it was pushed with, including pushes below the current key after
+    // the queue ran dry.
+    void testBucketQueue()
+    {
+        std::mt19937 random{19};
+        const int cSpan = 7;
+
+        BucketQueue queue;
+        std::priority_queue<
+            KeyedValue,
+            std::vector<KeyedValue>,
+            std::greater<KeyedValue>
+        > reference;
+        std::vector<int> keys;
+
+        for (auto round = 0; round < 3; ++round)
+        {
+            queue.reset(cSpan);
+            auto lastKey = 0;
+
+            for (auto operation = 0; operation < 2000; ++operation)
+            {
+                if (reference.empty() || random() % 3 != 0)
+                {
+                    auto key = lastKey + static_cast<int>(random() % cSpan);
+                    auto value = static_cast<std::uint32_t>(keys.size());
+                    keys.push_back(key);
+                    queue.push(value, key);
+                    reference.push({key, value});
+                    continue;
+                }
+
+                KINEMATIC_CHECK(!queue.isEmpty());
+                auto value = queue.pop();
+                lastKey = reference.top().first;
+                reference.pop();
+
+                KINEMATIC_CHECK(queue.getCurrentKey() == lastKey);
+                KINEMATIC_CHECK(keys[value] == lastKey);
+            }
+
+            while (!reference.empty())
+            {
+                auto value = queue.pop();
+                KINEMATIC_CHECK(keys[value] == reference.top().first);
+                reference.pop();
+            }
+
+            KINEMATIC_CHECK(queue.isEmpty());
+        }
+    }
+
+    TestRegistration gBucketQueue{"bucket-queue", testBucketQueue};
+
+    int getWrapped(int coord, int resolution)
+    {
+        return (coord % resolution + resolution) % resolution;
+    }
+
+    // Plain Dijkstra with a binary heap over the same step costs.
+    std::vector<int> findCosts(
+        const ConfigurationSpace& space,
+        const CostMap& costMap,
+        glm::ivec2 start
+    )
+    {
+        const int dirx[] = {-1, 0, +1, 0};
+        const int diry[] = {0, -1, 0, +1};
+
+        auto resolution = space.getResolution();
+        std::vector<int> costs(
+            resolution * resolution,
+            std::numeric_limits<int>::max()
+        );
+
+        std::priority_queue<
+            std::pair<int, int>,
+            std::vector<std::pair<int, int>>,
+            std::greater<std::pair<int, int>>
+        > openSet;
+
+        costs[start.x * resolution + start.y] = 0;
+        openSet.push({0, start.x * resolution + start.y});
+
+        while (!openSet.empty())
+        {
+            auto cost = openSet.top().first;
+            auto index = openSet.top().second;
+            openSet.pop();
+
+            if (cost != costs[index]) { continue; }
+
+            glm::ivec2 current{index / resolution, index % resolution};
+            for (auto i = 0; i < 4; ++i)
+            {
+                glm::ivec2 next{
+                    getWrapped(current.x + dirx[i], resolution),
+                    getWrapped(current.y + diry[i], resolution)
+                };
+
+                if (!space.verifyAvailability(next)) { continue; }
+
+                auto nextCost = cost + costMap.getStepCost(next, i % 2);
+                auto nextIndex = next.x * resolution + next.y;
+                if (nextCost < costs[nextIndex])
+                {
+                    costs[nextIndex] = nextCost;
+                    openSet.push({nextCost, nextIndex});
+                }
+            }
+        }
+
+        return costs;
+    }
+
+    // Sums the step costs along a path, or returns -1 when two
+    // consecutive cells are not neighbours or a cell is blocked.
+    int getPathCost(
+        const ConfigurationSpace& space,
+        const CostMap& costMap,
+        const std::vector<glm::ivec2>& path
+    )
+    {
+        auto resolution = space.getResolution();
+        auto cost = 0;
+
+        for (auto i = 1u; i < path.size(); ++i)
+        {
+            if (!space.verifyAvailability(path[i]))
+            {
+                return -1;
+            }
+
+            auto dx = getWrapped(path[i].x - path[i - 1].x, resolution);
+            auto dy = getWrapped(path[i].y - path[i - 1].y, resolution);
+            auto movesX = dx == 1 || dx == resolution - 1;
+            auto movesY = dy == 1 || dy == resolution - 1;
+
+            if (movesX == movesY || (movesX && dy != 0)
+                || (movesY && dx != 0))
+            {
+                return -1;
+            }
+
+            cost += costMap.getStepCost(path[i], movesX ? 0 : 1);
+        }
+
+        return cost;
+    }
+
+    // The bucket queue search finds paths exactly as cheap as a heap based
+    // search over the same costs, with unequal joint weights and clearance
+    // penalties in play.
+    void testCostMapPlanner()
+    {
+        std::mt19937 random{21};
+        std::uniform_real_distribution<float> position(-1.5f, 1.5f);
+        std::uniform_real_distribution<float> extent(0.02f, 0.2f);
+
+        ConfigurationSpace space;
+        space.setResolution(120);
+        for (auto i = 0; i < 20; ++i)
+        {
+            glm::vec2 centre{position(random), position(random)};
+            glm::vec2 half{extent(random), extent(random)};
+            space.addConstraint({centre - half, centre + half});
+        }
+
+        space.createAvailabilityMap();
+
+        CostMapPlanner planner;
+        planner.getCostMap().setJointWeights({1.0f, 2.5f});
+        planner.getCostMap().setClearanceRange(6);
+
+        auto resolution = space.getResolution();
+        std::uniform_int_distribution<int> step(0, resolution - 1);
+        auto getFreeCell = [&]()
+        {
+            glm::ivec2 cell;
+            do
+            {
+                cell = {step(random), step(random)};
+            }
+            while (!space.verifyAvailability(cell));
+
+            return cell;
+        };
+
+        auto foundPaths = 0;
+        for (auto query = 0; query < 30; ++query)
+        {
+            auto start = getFreeCell();
+            auto end = getFreeCell();
+
+            auto found = planner.findPath(space, start, end);
+            const auto& costMap = planner.getCostMap();
+            auto costs = findCosts(space, costMap, start);
+            auto expected = costs[end.x * resolution + end.y];
+
+            KINEMATIC_CHECK(
+                found == (expected != std::numeric_limits<int>::max())
+            );
+            if (!found)
+            {
+                continue;
+            }
+
+            ++foundPaths;
+            const auto& path = planner.getPath();
+            KINEMATIC_CHECK(path.front() == start && path.back() == end);
+            KINEMATIC_CHECK(getPathCost(space, costMap, path) == expected);
+        }
+
+        KINEMATIC_CHECK(foundPaths > 0);
+    }
+
+    TestRegistration gCostMapPlanner{"cost-map-planner", testCostMapPlanner};
+}
+
+}
+}
@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "BreadthFirstPlanner.hpp"
+#include "ConfigurationSpace.hpp"
+#include "DistanceField.hpp"
+#include "Tests.hpp"
+
+namespace kinematic
+{
+namespace test
+{
+
+namespace
+{
+    bool areNeighbours(glm::ivec2 first, glm::ivec2 second, int resolution)
+    {
+        auto dx = std::abs(first.x - second.x);
+        auto dy = std::abs(first.y - second.y);
+        dx = std::min(dx, resolution - dx);
+        dy = std::min(dy, resolution - dy);
+        return dx + dy == 1;
+    }
+
+    // Walking down the field from any start gives a shortest path to the
+    // goal, and the field stops being valid once the space changes.
+    void testDistanceField()
+    {
+        std::mt19937 random{10};
+        std::uniform_real_distribution<float> position(-0.6f, 0.6f);
+        std::uniform_real_distribution<float> extent(0.01f, 0.06f);
+
+        ConfigurationSpace space;
+        space.setResolution(150);
+        for (auto i = 0; i < 8; ++i)
+        {
+            glm::vec2 centre{position(random), position(random)};
+            glm::vec2 half{extent(random), extent(random)};
+            space.addConstraint({centre - half, centre + half});
+        }
+
+        space.createAvailabilityMap();
+
+        auto resolution = space.getResolution();
+        std::uniform_int_distribution<int> step(0, resolution - 1);
+        auto getFreeCell = [&]()
+        {
+            glm::ivec2 cell;
+            do
+            {
+                cell = {step(random), step(random)};
+            }
+            while (!space.verifyAvailability(cell));
+
+            return cell;
+        };
+
+        auto goal = getFreeCell();
+        DistanceField field;
+        field.create(space, goal);
+
+        KINEMATIC_CHECK(field.isValid(space, goal));
+        KINEMATIC_CHECK(field.getDistance(goal) == 0);
+
+        BreadthFirstPlanner reference;
+        std::vector<glm::ivec2> path;
+        auto reached = 0;
+
+        for (auto query = 0; query < 50; ++query)
+        {
+            auto start = getFreeCell();
+            auto found = reference.findPath(space, start, goal);
+
+            KINEMATIC_CHECK(field.descend(start, path) == found);
+            if (!found)
+            {
+                KINEMATIC_CHECK(
+                    field.getDistance(start) == DistanceField::cUnreachable
+                );
+                continue;
+            }
+
+            ++reached;
+            KINEMATIC_CHECK(path.size() == reference.getPath().size());
+            KINEMATIC_CHECK(
+                field.getDistance(start)
+                    == static_cast<int>(path.size()) - 1
+            );
+            KINEMATIC_CHECK(path.front() == start && path.back() == goal);
+
+            auto broken = 0;
+            for (auto i = 1u; i < path.size(); ++i)
+            {
+                broken += !space.verifyAvailability(path[i]);
+                broken += !areNeighbours(path[i - 1], path[i], resolution);
+            }
+
+            KINEMATIC_CHECK(broken == 0);
+        }
+
+        KINEMATIC_CHECK(reached > 0);
+
+        glm::ivec2 otherGoal{(goal.x + 1) % resolution, goal.y};
+        KINEMATIC_CHECK(!field.isValid(space, otherGoal));
+
+        space.addConstraint({{0.7f, 0.7f}, {0.75f, 0.75f}});
+        KINEMATIC_CHECK(!field.isValid(space));
+
+        field.create(space, goal);
+        KINEMATIC_CHECK(field.isValid(space, goal));
+        field.invalidate();
+        KINEMATIC_CHECK(!field.isValid(space));
+    }
+
+    TestRegistration gDistanceField{"distance-field", testDistanceField};
+}
+
+}
+}
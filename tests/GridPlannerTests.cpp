@@ -0,0 +1,189 @@
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "AStarPlanner.hpp"
+#include "BidirectionalPlanner.hpp"
+#include "BreadthFirstPlanner.hpp"
+#include "ConfigurationSpace.hpp"
+#include "JumpPointPlanner.hpp"
+#include "MultiQueryPlanner.hpp"
+#include "Tests.hpp"
+#include "ThetaStarPlanner.hpp"
+
+namespace kinematic
+{
+namespace test
+{
+
+namespace
+{
+    int getWrappedOffset(int from, int to, int resolution)
+    {
+        auto offset = to - from;
+        if (offset > resolution / 2) { offset -= resolution; }
+        if (offset < -resolution / 2) { offset += resolution; }
+        return offset;
+    }
+
+    // Every cell is free and consecutive cells are joined by a free line
+    // on the torus, which covers single steps and any-angle moves alike.
+    bool isPathValid(
+        const ConfigurationSpace& space,
+        const std::vector<glm::ivec2>& path,
+        glm::ivec2 start,
+        glm::ivec2 end
+    )
+    {
+        if (path.empty() || path.front() != start || path.back() != end)
+        {
+            return false;
+        }
+
+        auto resolution = space.getResolution();
+        for (auto i = 0u; i < path.size(); ++i)
+        {
+            if (!space.verifyAvailability(path[i]))
+            {
+                return false;
+            }
+
+            if (i == 0)
+            {
+                continue;
+            }
+
+            glm::ivec2 offset{
+                getWrappedOffset(path[i - 1].x, path[i].x, resolution),
+                getWrappedOffset(path[i - 1].y, path[i].y, resolution)
+            };
+
+            if (!space.checkCellLine(
+                glm::vec2{path[i - 1]},
+                glm::vec2{offset}))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    glm::ivec2 getRandomFreeCell(
+        const ConfigurationSpace& space,
+        std::mt19937& random
+    )
+    {
+        std::uniform_int_distribution<int> step(0, space.getResolution() - 1);
+
+        glm::ivec2 cell;
+        do
+        {
+            cell = {step(random), step(random)};
+        }
+        while (!space.verifyAvailability(cell));
+
+        return cell;
+    }
+
+    // The 4-connected planners find a path exactly when breadth-first
+    // search does, and their paths are just as short and only cross free
+    // cells. Runs on an empty map as well, where most rows and columns hold
+    // nothing to stop at.
+    void testGridPlanners()
+    {
+        std::mt19937 random{3};
+        std::uniform_real_distribution<float> position(-0.6f, 0.6f);
+        std::uniform_real_distribution<float> extent(0.01f, 0.06f);
+
+        std::vector<std::shared_ptr<PathPlanner>> shortestPlanners{
+            std::make_shared<AStarPlanner>(),
+            std::make_shared<JumpPointPlanner>(),
+            std::make_shared<BidirectionalPlanner>(),
+            std::make_shared<MultiQueryPlanner>()
+        };
+
+        auto eightConnected = std::make_shared<ThetaStarPlanner>();
+        eightConnected->setAnyAngle(false);
+        auto shortSighted = std::make_shared<ThetaStarPlanner>();
+        shortSighted->setSightLimit(4);
+
+        // Paths that may be shorter than four-connected ones; disconnected
+        // queries must be rejected before any cell is expanded.
+        std::vector<std::shared_ptr<PathPlanner>> otherPlanners{
+            eightConnected,
+            std::make_shared<ThetaStarPlanner>(),
+            shortSighted
+        };
+
+        BreadthFirstPlanner reference;
+        auto foundPaths = 0;
+
+        for (auto constraintCount: {0, 30})
+        {
+            ConfigurationSpace space;
+            for (auto i = 0; i < constraintCount; ++i)
+            {
+                glm::vec2 centre{position(random), position(random)};
+                glm::vec2 half{extent(random), extent(random)};
+                space.addConstraint({centre - half, centre + half});
+            }
+
+            space.createAvailabilityMap();
+
+            for (auto query = 0; query < 40; ++query)
+            {
+                auto start = getRandomFreeCell(space, random);
+                auto end = getRandomFreeCell(space, random);
+
+                auto found = reference.findPath(space, start, end);
+                const auto& referencePath = reference.getPath();
+                if (found)
+                {
+                    ++foundPaths;
+                    KINEMATIC_CHECK(
+                        isPathValid(space, referencePath, start, end)
+                    );
+                }
+
+                for (const auto& planner: shortestPlanners)
+                {
+                    KINEMATIC_CHECK(
+                        planner->findPath(space, start, end) == found
+                    );
+
+                    if (found)
+                    {
+                        const auto& path = planner->getPath();
+                        KINEMATIC_CHECK(isPathValid(space, path, start, end));
+                        KINEMATIC_CHECK(path.size() == referencePath.size());
+                    }
+                }
+
+                for (const auto& planner: otherPlanners)
+                {
+                    KINEMATIC_CHECK(
+                        planner->findPath(space, start, end) == found
+                    );
+
+                    if (found)
+                    {
+                        const auto& path = planner->getPath();
+                        KINEMATIC_CHECK(isPathValid(space, path, start, end));
+                    }
+                    else
+                    {
+                        KINEMATIC_CHECK(planner->getExpandedNodes() == 0);
+                    }
+                }
+            }
+        }
+
+        KINEMATIC_CHECK(foundPaths > 0);
+    }
+
+    TestRegistration gGridPlanners{"grid-planners", testGridPlanners};
+}
+
+}
+}
@@ -0,0 +1,126 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "InverseKinematics.hpp"
+#include "Tests.hpp"
+
+namespace kinematic
+{
+namespace test
+{
+
+namespace
+{
+    glm::vec2 getElbow(float firstArmLength, float alpha)
+    {
+        return firstArmLength * glm::vec2{std::cos(alpha), std::sin(alpha)};
+    }
+
+    glm::vec2 getTip(
+        float firstArmLength,
+        float secondArmLength,
+        float alpha,
+        float beta
+    )
+    {
+        return getElbow(firstArmLength, alpha) + secondArmLength
+            * glm::vec2{std::cos(alpha + beta), std::sin(alpha + beta)};
+    }
+
+    // Both solutions for a reachable target put the tip back on the
+    // target, with the elbow on the documented side, and targets out of
+    // reach are reported as such. The count leaves a scalar tail.
+    void testInverseKinematics()
+    {
+        const float cFirstArmLength = 0.4f;
+        const float cSecondArmLength = 0.25f;
+        const float cTolerance = 1e-4f;
+        const int cCount = 10007;
+
+        std::mt19937 random{13};
+        std::uniform_real_distribution<float> coordinate(-0.7f, 0.7f);
+
+        std::vector<float> targetX(cCount), targetY(cCount);
+        for (auto i = 0; i < cCount; ++i)
+        {
+            targetX[i] = coordinate(random);
+            targetY[i] = coordinate(random);
+        }
+
+        std::vector<float> alpha[2], beta[2];
+        for (auto side = 0; side < 2; ++side)
+        {
+            alpha[side].resize(cCount);
+            beta[side].resize(cCount);
+        }
+
+        std::vector<unsigned char> reachable(cCount);
+        auto reachableCount = solveInverseKinematics(
+            cFirstArmLength,
+            cSecondArmLength,
+            targetX.data(),
+            targetY.data(),
+            cCount,
+            {
+                {alpha[0].data(), alpha[1].data()},
+                {beta[0].data(), beta[1].data()},
+                reachable.data()
+            }
+        );
+
+        auto counted = 0, wrongReach = 0, missed = 0, wrongSide = 0;
+        for (auto i = 0; i < cCount; ++i)
+        {
+            glm::vec2 target{targetX[i], targetY[i]};
+            auto distance = glm::length(target);
+
+            // Targets right on the edge of the annulus may go either way.
+            auto inside = distance < cFirstArmLength + cSecondArmLength - 1e-5f
+                && distance > cFirstArmLength - cSecondArmLength + 1e-5f;
+            auto outside = distance > cFirstArmLength + cSecondArmLength + 1e-5f
+                || distance < cFirstArmLength - cSecondArmLength - 1e-5f;
+
+            wrongReach += (inside && !reachable[i])
+                || (outside && reachable[i]);
+            if (!reachable[i])
+            {
+                continue;
+            }
+
+            ++counted;
+            for (auto side = 0; side < 2; ++side)
+            {
+                auto tip = getTip(
+                    cFirstArmLength,
+                    cSecondArmLength,
+                    alpha[side][i],
+                    beta[side][i]
+                );
+                missed += glm::length(tip - target) > cTolerance;
+
+                auto elbow = getElbow(cFirstArmLength, alpha[side][i]);
+                auto cross = target.x * elbow.y - target.y * elbow.x;
+                wrongSide += side == 0
+                    ? cross < -cTolerance
+                    : cross > cTolerance;
+            }
+        }
+
+        KINEMATIC_CHECK(reachableCount == counted);
+        KINEMATIC_CHECK(counted > 0);
+        KINEMATIC_CHECK(wrongReach == 0);
+        KINEMATIC_CHECK(missed == 0);
+        KINEMATIC_CHECK(wrongSide == 0);
+    }
+
+    TestRegistration gInverseKinematics{
+        "inverse-kinematics",
+        testInverseKinematics
+    };
+}
+
+}
+}
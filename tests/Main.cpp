@@ -0,0 +1,78 @@
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "Tests.hpp"
+
+namespace kinematic
+{
+namespace test
+{
+
+namespace
+{
+    struct TestCase
+    {
+        const char* name;
+        void (*run)();
+    };
+
+    // Filled by registrations in other files before main runs, so it is
+    // created on first use rather than relying on initialisation order.
+    std::vector<TestCase>& getTestCases()
+    {
+        static std::vector<TestCase> testCases;
+        return testCases;
+    }
+
+    int gFailures = 0;
+}
+
+void check(bool condition, const char* expression, const char* file, int line)
+{
+    if (!condition)
+    {
+        ++gFailures;
+        std::printf("%s:%d: check failed: %s\n", file, line, expression);
+    }
+}
+
+TestRegistration::TestRegistration(const char* name, void (*run)())
+{
+    getTestCases().push_back({name, run});
+}
+
+}
+}
+
+// Runs the test named by the first argument, or all of them without one.
+int main(int argc, char** argv)
+{
+    using namespace kinematic::test;
+
+    auto found = argc < 2;
+    for (const auto& testCase: getTestCases())
+    {
+        if (argc > 1 && std::strcmp(argv[1], testCase.name) != 0)
+        {
+            continue;
+        }
+
+        found = true;
+        auto failures = gFailures;
+        testCase.run();
+        std::printf(
+            "%s: %s\n",
+            testCase.name,
+            gFailures == failures ? "passed" : "FAILED"
+        );
+    }
+
+    if (!found)
+    {
+        std::printf("unknown test: %s\n", argv[1]);
+        return 1;
+    }
+
+    return gFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,158 @@
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "ConfigurationSpace.hpp"
+#include "OccupancyGrid.hpp"
+#include "Tests.hpp"
+
+namespace kinematic
+{
+namespace test
+{
+
+namespace
+{
+    bool arePaddingBitsSet(const OccupancyGrid& grid)
+    {
+        auto bitsPerRow = grid.getWordsPerRow() * OccupancyGrid::cBitsPerWord;
+        for (auto row = 0; row < grid.getRows(); ++row)
+        {
+            auto words = grid.getRow(row);
+            for (auto bit = grid.getColumns(); bit < bitsPerRow; ++bit)
+            {
+                auto word = words[bit / OccupancyGrid::cBitsPerWord];
+                if (((word >> (bit % OccupancyGrid::cBitsPerWord)) & 1) == 0)
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    int countDifferences(
+        const OccupancyGrid& grid,
+        const std::vector<bool>& reference
+    )
+    {
+        auto differences = 0;
+        for (auto row = 0; row < grid.getRows(); ++row)
+        {
+            for (auto column = 0; column < grid.getColumns(); ++column)
+            {
+                differences += grid.isOccupied(row, column)
+                    != reference[row * grid.getColumns() + column];
+            }
+        }
+
+        return differences;
+    }
+
+    // Single cells and ranges set on grids whose widths straddle word
+    // boundaries match a plain array, and never touch the padding.
+    void testOccupancyGrid()
+    {
+        std::mt19937 random{5};
+        const int widths[] = {1, 63, 64, 65, 360, 513};
+
+        for (auto columns: widths)
+        {
+            const auto rows = 7;
+            OccupancyGrid grid{rows, columns};
+            std::vector<bool> reference(rows * columns, false);
+
+            KINEMATIC_CHECK(grid.countOccupied() == 0);
+            KINEMATIC_CHECK(arePaddingBitsSet(grid));
+
+            for (auto row = 0; row < rows; ++row)
+            {
+                auto address = reinterpret_cast<std::uintptr_t>(
+                    grid.getRow(row)
+                );
+                KINEMATIC_CHECK(address % OccupancyGrid::cCacheLineSize == 0);
+            }
+
+            std::uniform_int_distribution<int> anyRow(0, rows - 1);
+            std::uniform_int_distribution<int> anyColumn(0, columns);
+            for (auto edit = 0; edit < 300; ++edit)
+            {
+                auto row = anyRow(random);
+                auto occupied = random() % 2 == 0;
+                auto first = anyColumn(random);
+                auto last = anyColumn(random);
+                if (first > last)
+                {
+                    std::swap(first, last);
+                }
+
+                if (edit % 2 == 0 && first < columns)
+                {
+                    grid.setOccupied(row, first, occupied);
+                    reference[row * columns + first] = occupied;
+                }
+                else
+                {
+                    grid.setOccupied(row, first, last, occupied);
+                    for (auto column = first; column < last; ++column)
+                    {
+                        reference[row * columns + column] = occupied;
+                    }
+                }
+            }
+
+            auto occupied = 0;
+            for (auto cell: reference)
+            {
+                occupied += cell;
+            }
+
+            KINEMATIC_CHECK(countDifferences(grid, reference) == 0);
+            KINEMATIC_CHECK(grid.countOccupied() == occupied);
+            KINEMATIC_CHECK(arePaddingBitsSet(grid));
+
+            grid.fill(true);
+            KINEMATIC_CHECK(grid.countOccupied() == rows * columns);
+            grid.fill(false);
+            KINEMATIC_CHECK(grid.countOccupied() == 0);
+            KINEMATIC_CHECK(arePaddingBitsSet(grid));
+        }
+    }
+
+    // Maps whose rows end on a word boundary and maps whose rows do not both
+    // keep their padding when rows are refreshed from the obstacle counts.
+    void testMapPadding()
+    {
+        const int resolutions[] = {128, 150};
+
+        for (auto resolution: resolutions)
+        {
+            ConfigurationSpace space;
+            space.setResolution(resolution);
+            space.addConstraint({{0.1f, 0.1f}, {0.3f, 0.2f}});
+            space.createAvailabilityMap();
+
+            const auto& grid = space.getOccupancyGrid();
+            auto occupied = 0;
+            for (auto alpha = 0; alpha < resolution; ++alpha)
+            {
+                for (auto beta = 0; beta < resolution; ++beta)
+                {
+                    occupied += !space.verifyAvailability({alpha, beta});
+                }
+            }
+
+            KINEMATIC_CHECK(occupied > 0);
+            KINEMATIC_CHECK(grid.countOccupied() == occupied);
+            KINEMATIC_CHECK(arePaddingBitsSet(grid));
+        }
+    }
+
+    TestRegistration gOccupancyGrid{"occupancy-grid", testOccupancyGrid};
+    TestRegistration gMapPadding{"map-padding", testMapPadding};
+}
+
+}
+}
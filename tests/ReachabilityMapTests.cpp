@@ -0,0 +1,264 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "BreadthFirstPlanner.hpp"
+#include "ConfigurationSpace.hpp"
+#include "ReachabilityMap.hpp"
+#include "Tests.hpp"
+
+namespace kinematic
+{
+namespace test
+{
+
+namespace
+{
+    const double cEdgeMargin = 1e-4;
+
+    // Slab test in double precision, with every box grown by `margin`.
+    bool intersectsBox(
+        glm::dvec2 start,
+        glm::dvec2 end,
+        const fw::AABB<glm::vec2>& box,
+        double margin
+    )
+    {
+        double enter = 0.0, leave = 1.0;
+        auto delta = end - start;
+
+        for (auto axis = 0; axis < 2; ++axis)
+        {
+            auto low = box.min[axis] - margin;
+            auto high = box.max[axis] + margin;
+
+            if (std::abs(delta[axis]) < 1e-12)
+            {
+                if (start[axis] < low || start[axis] > high)
+                {
+                    return false;
+                }
+
+                continue;
+            }
+
+            auto first = (low - start[axis]) / delta[axis];
+            auto second = (high - start[axis]) / delta[axis];
+            enter = std::max(enter, std::min(first, second));
+            leave = std::min(leave, std::max(first, second));
+        }
+
+        return enter <= leave;
+    }
+
+    // 1 when free, 0 when blocked, -1 when an obstacle passes so close that
+    // rounding may decide either way.
+    int checkArm(
+        const ConfigurationSpace& space,
+        double alpha,
+        double beta
+    )
+    {
+        double first = space.getFirstArmLength();
+        double second = space.getSecondArmLength();
+        glm::dvec2 elbow{first * std::cos(alpha), first * std::sin(alpha)};
+        glm::dvec2 tip{
+            elbow.x + second * std::cos(alpha + beta),
+            elbow.y + second * std::sin(alpha + beta)
+        };
+
+        bool grown = false, shrunk = false;
+        for (const auto& box: space.getConstraints())
+        {
+            grown |= intersectsBox({0.0, 0.0}, elbow, box, cEdgeMargin)
+                || intersectsBox(elbow, tip, box, cEdgeMargin);
+            shrunk |= intersectsBox({0.0, 0.0}, elbow, box, -cEdgeMargin)
+                || intersectsBox(elbow, tip, box, -cEdgeMargin);
+        }
+
+        if (grown != shrunk)
+        {
+            return -1;
+        }
+
+        return grown ? 0 : 1;
+    }
+
+    // Counts of free solutions match a double precision law of cosines and
+    // slab tests, and solutions count as connected exactly when a search
+    // joins their cells. Samples on the edge of the reachable annulus or
+    // grazing an obstacle are skipped.
+    void testReachabilityMap()
+    {
+        std::mt19937 random{23};
+        std::uniform_real_distribution<float> position(-1.5f, 1.5f);
+        std::uniform_real_distribution<float> extent(0.05f, 0.25f);
+
+        ConfigurationSpace space;
+        space.setResolution(120);
+        space.setArmLengths(1.0f, 0.7f);
+        for (auto i = 0; i < 6; ++i)
+        {
+            glm::vec2 centre{position(random), position(random)};
+            glm::vec2 half{extent(random), extent(random)};
+            space.addConstraint({centre - half, centre + half});
+        }
+
+        fw::AABB<glm::vec2> area{{-1.8f, -1.8f}, {1.8f, 1.8f}};
+        ReachabilityMap map;
+        map.setResolution(60, 50);
+
+        // Without a map nothing counts as connected.
+        map.create(space, area);
+        KINEMATIC_CHECK(map.isValid(space, area));
+
+        auto unconnected = 0;
+        for (auto row = 0; row < map.getRows(); ++row)
+        {
+            for (auto column = 0; column < map.getColumns(); ++column)
+            {
+                unconnected += map.areSolutionsConnected(column, row) ? 0 : 1;
+            }
+        }
+        KINEMATIC_CHECK(unconnected == map.getColumns() * map.getRows());
+
+        space.createAvailabilityMap();
+        KINEMATIC_CHECK(!map.isValid(space, area));
+
+        map.create(space, area);
+        KINEMATIC_CHECK(map.isValid(space, area));
+
+        double first = space.getFirstArmLength();
+        double second = space.getSecondArmLength();
+        BreadthFirstPlanner planner;
+        auto counted = 0, searched = 0, connected = 0;
+
+        for (auto row = 0; row < map.getRows(); ++row)
+        {
+            for (auto column = 0; column < map.getColumns(); ++column)
+            {
+                glm::dvec2 target{map.getSamplePosition(column, row)};
+                auto distance = std::hypot(target.x, target.y);
+
+                if (std::abs(distance - (first + second)) < cEdgeMargin
+                    || std::abs(distance - std::abs(first - second))
+                        < cEdgeMargin)
+                {
+                    continue;
+                }
+
+                if (distance > first + second
+                    || distance < std::abs(first - second))
+                {
+                    KINEMATIC_CHECK(map.getSolutionCount(column, row) == 0);
+                    continue;
+                }
+
+                auto cosine = (distance * distance - first * first
+                    - second * second) / (2.0 * first * second);
+                auto elbow = std::acos(std::max(-1.0, std::min(1.0, cosine)));
+                auto heading = std::atan2(target.y, target.x);
+
+                double alpha[2], beta[2] = {elbow, -elbow};
+                auto expected = 0;
+                bool ambiguous = false;
+
+                for (auto side = 0; side < 2; ++side)
+                {
+                    alpha[side] = heading - std::atan2(
+                        second * std::sin(beta[side]),
+                        first + second * std::cos(beta[side])
+                    );
+
+                    auto free = checkArm(space, alpha[side], beta[side]);
+                    ambiguous |= free < 0;
+                    expected += free > 0 ? 1 : 0;
+                }
+
+                if (ambiguous)
+                {
+                    continue;
+                }
+
+                ++counted;
+                KINEMATIC_CHECK(
+                    map.getSolutionCount(column, row) == expected
+                );
+
+                // Searching is slow next to everything else here, so only
+                // every seventh pair of free solutions is searched.
+                if (expected < 2 || counted % 7 != 0)
+                {
+                    continue;
+                }
+
+                glm::ivec2 cells[2];
+                for (auto side = 0; side < 2; ++side)
+                {
+                    cells[side] = space.getClosestInConfiguration({
+                        static_cast<float>(alpha[side]),
+                        static_cast<float>(beta[side])
+                    });
+                }
+
+                auto found = space.verifyAvailability(cells[0])
+                    && space.verifyAvailability(cells[1])
+                    && planner.findPath(space, cells[0], cells[1]);
+
+                ++searched;
+                connected += found ? 1 : 0;
+                KINEMATIC_CHECK(
+                    map.areSolutionsConnected(column, row) == found
+                );
+            }
+        }
+
+        KINEMATIC_CHECK(counted > 0);
+        KINEMATIC_CHECK(searched > 0 && connected > 0);
+    }
+
+    TestRegistration gReachabilityMap{
+        "reachability-map",
+        testReachabilityMap
+    };
+
+    // A copy of the space finds the map valid, and a cancelled build
+    // leaves an invalid map behind.
+    void testReachabilityJob()
+    {
+        ConfigurationSpace space;
+        space.setResolution(90);
+        space.addConstraint({{0.5f, 0.5f}, {0.8f, 0.7f}});
+        space.createAvailabilityMap();
+
+        fw::AABB<glm::vec2> area{{-1.0f, -1.0f}, {1.0f, 1.0f}};
+        ReachabilityMap map;
+        map.setResolution(40, 40);
+
+        JobProgress progress;
+        KINEMATIC_CHECK(map.create(space, area, &progress));
+        KINEMATIC_CHECK(progress.getProgress() == 1.0f);
+
+        ConfigurationSpace copy{space};
+        KINEMATIC_CHECK(map.isValid(copy, area));
+
+        copy.addConstraint({{-0.5f, 0.5f}, {-0.4f, 0.7f}});
+        KINEMATIC_CHECK(!map.isValid(copy, area));
+
+        progress.reset();
+        progress.cancel();
+        KINEMATIC_CHECK(!map.create(space, area, &progress));
+        KINEMATIC_CHECK(!map.isValid(space, area));
+    }
+
+    TestRegistration gReachabilityJob{
+        "reachability-job",
+        testReachabilityJob
+    };
+}
+
+}
+}
@@ -0,0 +1,169 @@
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "AStarPlanner.hpp"
+#include "BreadthFirstPlanner.hpp"
+#include "ConfigurationSpace.hpp"
+#include "JumpPointPlanner.hpp"
+#include "SearchWorkspace.hpp"
+#include "Tests.hpp"
+
+namespace kinematic
+{
+namespace test
+{
+
+namespace
+{
+    // Marks and parent directions of one search are gone after the next
+    // reset, whether or not the cell count changes, and the frontier keeps
+    // its order when it wraps around its ring buffer.
+    void testSearchWorkspace()
+    {
+        SearchWorkspace workspace;
+        const int cellCounts[] = {37, 37, 64, 5, 37};
+
+        for (auto cellCount: cellCounts)
+        {
+            workspace.reset(cellCount);
+
+            auto visited = 0;
+            for (auto cell = 0; cell < cellCount; ++cell)
+            {
+                visited += workspace.isVisited(cell);
+            }
+
+            KINEMATIC_CHECK(visited == 0);
+            KINEMATIC_CHECK(workspace.isFrontierEmpty());
+
+            // Neighbouring cells share a byte of packed directions.
+            for (auto cell = 0; cell < cellCount; cell += 2)
+            {
+                workspace.visit(cell, cell % 4);
+            }
+
+            auto wrong = 0;
+            for (auto cell = 0; cell < cellCount; ++cell)
+            {
+                auto even = cell % 2 == 0;
+                wrong += workspace.isVisited(cell) != even;
+                wrong += even && workspace.getDirection(cell) != cell % 4;
+            }
+
+            KINEMATIC_CHECK(wrong == 0);
+
+            std::uint32_t next = 0, expected = 0;
+            for (auto round = 0; round < 3 * cellCount; ++round)
+            {
+                while (workspace.getFrontierSize()
+                    < static_cast<std::uint32_t>(cellCount))
+                {
+                    workspace.pushFrontier(next++);
+                }
+
+                for (auto pop = 0; pop < 1 + round % 3; ++pop)
+                {
+                    wrong += workspace.popFrontier() != expected++;
+                }
+            }
+
+            KINEMATIC_CHECK(wrong == 0);
+        }
+    }
+
+    int countVisited(const PathPlanner& planner, int resolution)
+    {
+        auto visited = 0;
+        for (auto alpha = 0; alpha < resolution; ++alpha)
+        {
+            for (auto beta = 0; beta < resolution; ++beta)
+            {
+                visited += planner.getSearchMapState({alpha, beta})
+                    != PathPlanner::cSearchMapUnvisited;
+            }
+        }
+
+        return visited;
+    }
+
+    // Planners reused across queries and resolutions give the same paths
+    // as fresh ones, and a short search shows none of the long search
+    // before it in its map.
+    void testSearchReuse()
+    {
+        std::mt19937 random{8};
+        std::uniform_real_distribution<float> position(-0.6f, 0.6f);
+        std::uniform_real_distribution<float> extent(0.01f, 0.06f);
+
+        std::vector<fw::AABB<glm::vec2>> constraints;
+        for (auto i = 0; i < 20; ++i)
+        {
+            glm::vec2 centre{position(random), position(random)};
+            glm::vec2 half{extent(random), extent(random)};
+            constraints.push_back({centre - half, centre + half});
+        }
+
+        std::vector<std::shared_ptr<PathPlanner>> planners{
+            std::make_shared<BreadthFirstPlanner>(),
+            std::make_shared<AStarPlanner>(),
+            std::make_shared<JumpPointPlanner>()
+        };
+
+        const int resolutions[] = {120, 90, 120};
+        for (auto resolution: resolutions)
+        {
+            ConfigurationSpace space;
+            space.setResolution(resolution);
+            space.setConstraints(constraints);
+            space.createAvailabilityMap();
+
+            std::uniform_int_distribution<int> step(0, resolution - 1);
+            auto getFreeCell = [&]()
+            {
+                glm::ivec2 cell;
+                do
+                {
+                    cell = {step(random), step(random)};
+                }
+                while (!space.verifyAvailability(cell));
+
+                return cell;
+            };
+
+            for (auto query = 0; query < 10; ++query)
+            {
+                auto start = getFreeCell();
+                auto end = getFreeCell();
+
+                BreadthFirstPlanner fresh;
+                auto found = fresh.findPath(space, start, end);
+
+                for (const auto& planner: planners)
+                {
+                    KINEMATIC_CHECK(
+                        planner->findPath(space, start, end) == found
+                    );
+                    KINEMATIC_CHECK(
+                        planner->getPath().size() == fresh.getPath().size()
+                    );
+
+                    auto visited = countVisited(*planner, resolution);
+                    KINEMATIC_CHECK(planner->findPath(space, start, start));
+                    KINEMATIC_CHECK(planner->getPath().size() == 1);
+                    KINEMATIC_CHECK(
+                        countVisited(*planner, resolution) <= visited
+                    );
+                    KINEMATIC_CHECK(countVisited(*planner, resolution) <= 5);
+                }
+            }
+        }
+    }
+
+    TestRegistration gSearchWorkspace{"search-workspace", testSearchWorkspace};
+    TestRegistration gSearchReuse{"search-reuse", testSearchReuse};
+}
+
+}
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+namespace kinematic
+{
+namespace test
+{
+
+// Records a failed check and carries on, so one run reports every failure.
+void check(bool condition, const char* expression, const char* file, int line);
+
+#define KINEMATIC_CHECK(condition) \
+    ::kinematic::test::check((condition), #condition, __FILE__, __LINE__)
+
+// Adds a case to the runner. Test files keep one at namespace scope per
+// case; the name is what CTest passes on the command line.
+class TestRegistration
+{
+public:
+    TestRegistration(const char* name, void (*run)());
+};
+
+}
+}
@@ -0,0 +1,109 @@
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "ConfigurationSpace.hpp"
+#include "ThreadPool.hpp"
+#include "Tests.hpp"
+
+namespace kinematic
+{
+namespace test
+{
+
+namespace
+{
+    // Every index in the range is handed to the body exactly once, however
+    // the range is split into chunks.
+    void testParallelForCoverage()
+    {
+        const unsigned int threadCounts[] = {1, 2, 3, 8};
+        const int grainSizes[] = {1, 7, 64, 1000};
+
+        for (auto threadCount: threadCounts)
+        {
+            ThreadPool threadPool{threadCount};
+            KINEMATIC_CHECK(threadPool.getThreadCount() == threadCount);
+
+            for (auto grainSize: grainSizes)
+            {
+                std::vector<int> visits(997, 0);
+                threadPool.parallelFor(
+                    3,
+                    static_cast<int>(visits.size()),
+                    grainSize,
+                    [&](int first, int last) {
+                        for (auto i = first; i < last; ++i)
+                        {
+                            ++visits[i];
+                        }
+                    }
+                );
+
+                auto wrong = 0;
+                for (auto i = 0; i < static_cast<int>(visits.size()); ++i)
+                {
+                    wrong += visits[i] != (i >= 3 ? 1 : 0);
+                }
+
+                KINEMATIC_CHECK(wrong == 0);
+            }
+        }
+    }
+
+    // The map does not depend on how many threads built it.
+    void testThreadCountIndependence()
+    {
+        std::mt19937 random{2};
+        std::uniform_real_distribution<float> position(-0.6f, 0.6f);
+        std::uniform_real_distribution<float> extent(0.01f, 0.08f);
+
+        std::vector<fw::AABB<glm::vec2>> constraints;
+        for (auto i = 0; i < 12; ++i)
+        {
+            glm::vec2 centre{position(random), position(random)};
+            glm::vec2 half{extent(random), extent(random)};
+            constraints.push_back({centre - half, centre + half});
+        }
+
+        ConfigurationSpace reference;
+        reference.setThreadPool(std::make_shared<ThreadPool>(1));
+        reference.setConstraints(constraints);
+        reference.createAvailabilityMap();
+
+        const unsigned int threadCounts[] = {2, 5};
+        for (auto threadCount: threadCounts)
+        {
+            ConfigurationSpace space;
+            space.setThreadPool(std::make_shared<ThreadPool>(threadCount));
+            space.setConstraints(constraints);
+            space.createAvailabilityMap();
+
+            auto resolution = space.getResolution();
+            auto differences = 0;
+            for (auto alpha = 0; alpha < resolution; ++alpha)
+            {
+                for (auto beta = 0; beta < resolution; ++beta)
+                {
+                    differences += space.verifyAvailability({alpha, beta})
+                        != reference.verifyAvailability({alpha, beta});
+                }
+            }
+
+            KINEMATIC_CHECK(differences == 0);
+        }
+    }
+
+    TestRegistration gParallelForCoverage{
+        "parallel-for-coverage",
+        testParallelForCoverage
+    };
+
+    TestRegistration gThreadCountIndependence{
+        "thread-count-independence",
+        testThreadCountIndependence
+    };
+}
+
+}
+}
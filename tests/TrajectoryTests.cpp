@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "ChainConfigurationSpace.hpp"
+#include "Tests.hpp"
+#include "Trajectory.hpp"
+
+namespace kinematic
+{
+namespace test
+{
+
+namespace
+{
+    // Closed-form rest-to-rest move over `distance` under a velocity and an
+    // acceleration limit: a triangle when the top speed is never reached,
+    // a trapezoid otherwise.
+    float getTrapezoidDuration(
+        float distance,
+        float velocity,
+        float acceleration
+    )
+    {
+        if (distance * acceleration < velocity * velocity)
+        {
+            return 2.0f * std::sqrt(distance / acceleration);
+        }
+
+        return distance / velocity + velocity / acceleration;
+    }
+
+    float getTrapezoidPosition(
+        float time,
+        float distance,
+        float velocity,
+        float acceleration
+    )
+    {
+        auto duration = getTrapezoidDuration(distance, velocity, acceleration);
+        auto top = std::min(velocity, std::sqrt(distance * acceleration));
+        auto ramp = top / acceleration;
+
+        time = std::max(0.0f, std::min(time, duration));
+        if (time < ramp)
+        {
+            return 0.5f * acceleration * time * time;
+        }
+
+        if (time > duration - ramp)
+        {
+            auto left = duration - time;
+            return distance - 0.5f * acceleration * left * left;
+        }
+
+        return 0.5f * acceleration * ramp * ramp + top * (time - ramp);
+    }
+
+    // Straight moves take exactly the closed-form time: along one joint
+    // with its own limits, and along the diagonal where the tighter joint
+    // sets the pace.
+    void testTrapezoidTiming()
+    {
+        const float cVelocity = 1.5f;
+        const float cAcceleration = 4.0f;
+
+        Trajectory trajectory;
+        trajectory.setVelocityLimits({cVelocity, 3.0f});
+        trajectory.setAccelerationLimits({cAcceleration, 6.0f});
+
+        JointVector angles;
+        for (auto distance: {0.3f, 2.0f})
+        {
+            for (auto diagonal: {false, true})
+            {
+                JointVector start{-1.0f, 0.5f};
+                JointVector end{
+                    -1.0f + distance,
+                    diagonal ? 0.5f + distance : 0.5f
+                };
+                trajectory.create({start, end});
+
+                auto duration = getTrapezoidDuration(
+                    distance,
+                    cVelocity,
+                    cAcceleration
+                );
+                KINEMATIC_CHECK(
+                    std::abs(trajectory.getDuration() - duration)
+                        < 0.01f * duration
+                );
+
+                for (auto i = 0; i <= 20; ++i)
+                {
+                    auto time = duration * i / 20.0f;
+                    auto expected = getTrapezoidPosition(
+                        time,
+                        distance,
+                        cVelocity,
+                        cAcceleration
+                    );
+
+                    trajectory.sample(time, angles);
+                    auto first = ChainConfigurationSpace::getAngleDifference(
+                        -1.0f,
+                        angles[0]
+                    );
+                    auto second = ChainConfigurationSpace::getAngleDifference(
+                        0.5f,
+                        angles[1]
+                    );
+
+                    KINEMATIC_CHECK(std::abs(first - expected) < 0.01f);
+                    KINEMATIC_CHECK(
+                        std::abs(second - (diagonal ? expected : 0.0f))
+                            < 0.01f
+                    );
+                }
+            }
+        }
+    }
+
+    TestRegistration gTrapezoidTiming{
+        "trapezoid-timing",
+        testTrapezoidTiming
+    };
+
+    // Along a path with corners and a move across the angle wrap, joint
+    // speeds measured from samples stay within their limits and the motion
+    // starts and ends at the path's ends.
+    void testTrajectoryLimits()
+    {
+        const JointVector cVelocityLimits{1.0f, 2.0f, 1.5f};
+        const float cTimeStep = 0.002f;
+
+        Trajectory trajectory;
+        trajectory.setVelocityLimits(cVelocityLimits);
+
+        std::vector<JointVector> path{
+            {0.0f, 0.0f, 0.0f},
+            {1.0f, 0.2f, -0.5f},
+            {1.2f, 1.5f, 0.5f},
+            {3.0f, -3.0f, 1.0f}
+        };
+        trajectory.create(path);
+
+        JointVector angles, previous;
+        trajectory.sample(0.0f, previous);
+        for (auto joint = 0; joint < 3; ++joint)
+        {
+            KINEMATIC_CHECK(
+                std::abs(previous[joint] - path[0][joint]) < 1e-5f
+            );
+        }
+
+        auto steps = static_cast<int>(trajectory.getDuration() / cTimeStep);
+        for (auto step = 1; step <= steps + 1; ++step)
+        {
+            trajectory.sample(step * cTimeStep, angles);
+            for (auto joint = 0; joint < 3; ++joint)
+            {
+                auto speed = std::abs(
+                    ChainConfigurationSpace::getAngleDifference(
+                        previous[joint],
+                        angles[joint]
+                    )
+                ) / cTimeStep;
+                KINEMATIC_CHECK(speed < 1.02f * cVelocityLimits[joint]);
+            }
+
+            previous = angles;
+        }
+
+        for (auto joint = 0; joint < 3; ++joint)
+        {
+            auto error = ChainConfigurationSpace::getAngleDifference(
+                angles[joint],
+                path.back()[joint]
+            );
+            KINEMATIC_CHECK(std::abs(error) < 1e-4f);
+        }
+    }
+
+    TestRegistration gTrajectoryLimits{
+        "trajectory-limits",
+        testTrajectoryLimits
+    };
+}
+
+}
+}
@@ -0,0 +1,55 @@
+#include <algorithm>
+#include <cmath>
+
+#include "ConfigurationSpace.hpp"
+#include "TrigonometryTable.hpp"
+#include "Tests.hpp"
+
+namespace kinematic
+{
+namespace test
+{
+
+namespace
+{
+    // The table agrees with the cell angles the map is indexed by, for
+    // resolutions that do and do not split the turn into nice angles.
+    void testTrigonometryTable()
+    {
+        const int resolutions[] = {4, 90, 360, 1001};
+
+        for (auto resolution: resolutions)
+        {
+            ConfigurationSpace space;
+            space.setResolution(resolution);
+
+            TrigonometryTable table;
+            table.create(resolution);
+            KINEMATIC_CHECK(table.getResolution() == resolution);
+
+            auto worst = 0.0f;
+            for (auto step = 0; step < resolution; ++step)
+            {
+                auto angle = space.getCellAngle(step);
+                worst = std::max(
+                    worst,
+                    std::fabs(table.getCos(step) - std::cos(angle))
+                );
+                worst = std::max(
+                    worst,
+                    std::fabs(table.getSin(step) - std::sin(angle))
+                );
+            }
+
+            KINEMATIC_CHECK(worst < 1.0e-5f);
+        }
+    }
+
+    TestRegistration gTrigonometryTable{
+        "trigonometry-table",
+        testTrigonometryTable
+    };
+}
+
+}
+}